@@ -12,6 +12,7 @@
 #pragma once
 #include <string>
 #include <map>
+#include <functional>
 
 #include "knowhere/index/vector_index/VecIndex.h"
 
@@ -27,4 +28,7 @@ struct LoadFieldDataInfo {
     int64_t field_id;
     const void* blob = nullptr;
     int64_t row_count = -1;
+    // if set, the segment keeps blob without copying and calls release once the field is dropped,
+    // blob must stay valid and unchanged until then
+    std::function<void()> release;
 };
@@ -68,6 +68,11 @@ struct SearchResult {
         return topk_ * num_queries_;
     }
 
+    const char*
+    get_row_data(int64_t index) const {
+        return row_data_.data() + index * row_data_sizeof_;
+    }
+
  public:
     int64_t num_queries_;
     int64_t topk_;
@@ -77,8 +82,11 @@ struct SearchResult {
     // TODO(gexi): utilize these field
     void* segment_;
     std::vector<int64_t> internal_seg_offsets_;
+    std::vector<int64_t> primary_keys_;
     std::vector<int64_t> result_offsets_;
-    std::vector<std::vector<char>> row_data_;
+    // target entries of all hits, packed row after row in one buffer
+    std::vector<char> row_data_;
+    int64_t row_data_sizeof_ = 0;
 };
 
 using SearchResultPtr = std::shared_ptr<SearchResult>;
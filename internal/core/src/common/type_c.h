@@ -47,6 +47,19 @@ typedef struct CLoadFieldDataInfo {
     int64_t row_count;
 } CLoadFieldDataInfo;
 
+// bytes held by a segment, see segcore/MemoryUsage.h for the categories
+typedef struct CMemoryUsage {
+    int64_t field_data;
+    int64_t system_field_data;
+    int64_t vector_index;
+    int64_t scalar_index;
+    int64_t primary_key_index;
+    int64_t timestamp_index;
+    int64_t delete_record;
+    int64_t cache;
+    int64_t total;
+} CMemoryUsage;
+
 typedef struct CProtoResult {
     CStatus status;
     CProto proto;
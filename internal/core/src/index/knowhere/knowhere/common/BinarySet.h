@@ -24,6 +24,8 @@ namespace knowhere {
 struct Binary {
     std::shared_ptr<uint8_t[]> data;
     int64_t size = 0;
+    // false if data only borrows memory of the caller (e.g. a Go slice), an index must copy it to keep it
+    bool owned = true;
 };
 using BinaryPtr = std::shared_ptr<Binary>;
 
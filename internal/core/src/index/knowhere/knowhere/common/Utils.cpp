@@ -26,6 +26,18 @@ static const char* NAME = "name";
 static const char* SLICE_NUM = "slice_num";
 static const char* TOTAL_LEN = "total_len";
 
+// binary itself if it is owned, otherwise a copy that is
+static BinaryPtr
+Owned(const BinaryPtr& binary) {
+    if (binary->owned) {
+        return binary;
+    }
+    auto copy = std::make_shared<Binary>();
+    copy->data = std::shared_ptr<uint8_t[]>(CopyBinary(binary));
+    copy->size = binary->size;
+    return copy;
+}
+
 void
 Slice(const std::string& prefix,
       const BinaryPtr& data_src,
@@ -40,9 +52,12 @@ Slice(const std::string& prefix,
     for (int64_t i = 0; i < data_src->size; ++slice_num) {
         int64_t ri = std::min(i + slice_len, data_src->size);
         auto size = static_cast<size_t>(ri - i);
-        auto slice_i = std::shared_ptr<uint8_t[]>(new uint8_t[size]);
-        memcpy(slice_i.get(), data_src->data.get() + i, size);
-        binarySet.Append(prefix + "_" + std::to_string(slice_num), slice_i, ri - i);
+        // slices share the source buffer instead of copying it
+        auto slice_i = std::make_shared<Binary>();
+        slice_i->data = std::shared_ptr<uint8_t[]>(data_src->data, data_src->data.get() + i);
+        slice_i->size = size;
+        slice_i->owned = data_src->owned;
+        binarySet.Append(prefix + "_" + std::to_string(slice_num), slice_i);
         i = ri;
     }
     ret[NAME] = prefix;
@@ -51,7 +66,7 @@ Slice(const std::string& prefix,
 }
 
 void
-Assemble(BinarySet& binarySet) {
+Assemble(BinarySet& binarySet, const std::unordered_set<std::string>& keep_sliced) {
     auto slice_meta = binarySet.Erase(INDEX_FILE_SLICE_META);
     if (slice_meta == nullptr) {
         return;
@@ -60,10 +75,31 @@ Assemble(BinarySet& binarySet) {
     milvus::json meta_data =
         milvus::json::parse(std::string(reinterpret_cast<char*>(slice_meta->data.get()), slice_meta->size));
 
+    bool has_kept_slices = false;
     for (auto& item : meta_data[META]) {
         std::string prefix = item[NAME];
         int slice_num = item[SLICE_NUM];
         auto total_len = static_cast<size_t>(item[TOTAL_LEN]);
+        if (keep_sliced.count(prefix)) {
+            has_kept_slices = true;
+            continue;
+        }
+        if (binarySet.Contains(prefix)) {
+            auto binary = binarySet.GetByName(prefix);
+            if (binary->size != static_cast<int64_t>(total_len)) {
+                KNOWHERE_THROW_MSG("size of " + prefix + " mismatches its slice meta");
+            }
+            for (auto i = 0; i < slice_num; ++i) {
+                binarySet.Erase(prefix + "_" + std::to_string(i));
+            }
+            // indexes keep assembled keys after Load, so borrowed memory is copied
+            binarySet.Append(prefix, Owned(binary));
+            continue;
+        }
+        if (slice_num == 1) {
+            binarySet.Append(prefix, Owned(binarySet.Erase(prefix + "_0")));
+            continue;
+        }
         auto p_data = std::shared_ptr<uint8_t[]>(new uint8_t[total_len]);
         int64_t pos = 0;
         for (auto i = 0; i < slice_num; ++i) {
@@ -73,6 +109,52 @@ Assemble(BinarySet& binarySet) {
         }
         binarySet.Append(prefix, p_data, total_len);
     }
+
+    // assembled keys are skipped by later calls, so the meta can be kept as is
+    if (has_kept_slices) {
+        binarySet.Append(INDEX_FILE_SLICE_META, slice_meta);
+    }
+}
+
+std::vector<BinaryPtr>
+GetSlices(const BinarySet& binarySet, const std::string& key) {
+    if (binarySet.Contains(key)) {
+        return {binarySet.GetByName(key)};
+    }
+    auto slice_meta = binarySet.GetByName(INDEX_FILE_SLICE_META);
+    milvus::json meta_data =
+        milvus::json::parse(std::string(reinterpret_cast<char*>(slice_meta->data.get()), slice_meta->size));
+    for (auto& item : meta_data[META]) {
+        if (item[NAME] != key) {
+            continue;
+        }
+        int slice_num = item[SLICE_NUM];
+        std::vector<BinaryPtr> slices;
+        for (auto i = 0; i < slice_num; ++i) {
+            slices.push_back(binarySet.GetByName(key + "_" + std::to_string(i)));
+        }
+        return slices;
+    }
+    KNOWHERE_THROW_MSG("binary " + key + " not found");
+}
+
+void
+CopyFromSlices(const std::vector<BinaryPtr>& slices,
+               const std::vector<int64_t>& slice_offsets,
+               int64_t offset,
+               int64_t size,
+               uint8_t* dst) {
+    // slice_offsets[i] is the start of slices[i]
+    auto i = std::upper_bound(slice_offsets.begin(), slice_offsets.end(), offset) - slice_offsets.begin() - 1;
+    while (size > 0) {
+        auto in_slice = offset - slice_offsets[i];
+        auto n = std::min(size, slices[i]->size - in_slice);
+        memcpy(dst, slices[i]->data.get() + in_slice, n);
+        dst += n;
+        offset += n;
+        size -= n;
+        ++i;
+    }
 }
 
 void
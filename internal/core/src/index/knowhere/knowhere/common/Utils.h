@@ -12,6 +12,8 @@
 #pragma once
 
 #include <string>
+#include <unordered_set>
+#include <vector>
 #include "BinarySet.h"
 #include "Config.h"
 #include "Exception.h"
@@ -23,8 +25,22 @@ namespace knowhere {
 extern const char* INDEX_FILE_SLICE_SIZE_IN_MEGABYTE;
 extern const char* INDEX_FILE_SLICE_META;
 
+// keys in keep_sliced stay as slices, keys already present in full (e.g. read straight
+// into a buffer by the caller) and single slices are not copied again unless they borrow the caller's memory
 void
-Assemble(BinarySet& binarySet);
+Assemble(BinarySet& binarySet, const std::unordered_set<std::string>& keep_sliced = {});
+
+// slices of key in order, or the key itself if it is not sliced
+std::vector<BinaryPtr>
+GetSlices(const BinarySet& binarySet, const std::string& key);
+
+// copy [offset, offset + size) of the data spread over slices into dst
+void
+CopyFromSlices(const std::vector<BinaryPtr>& slices,
+               const std::vector<int64_t>& slice_offsets,
+               int64_t offset,
+               int64_t size,
+               uint8_t* dst);
 
 void
 Disassemble(const int64_t& slice_size_in_byte, BinarySet& binarySet);
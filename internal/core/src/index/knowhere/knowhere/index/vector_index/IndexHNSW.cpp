@@ -164,28 +164,27 @@ IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config, const fais
 #pragma omp parallel for
     for (unsigned int i = 0; i < rows; ++i) {
         auto single_query = (float*)p_data + i * dim;
-        std::priority_queue<std::pair<float, hnswlib::labeltype>> rst;
+        // heaps, visited list and results are reused by the queries of this index
+        auto ctx_ptr = index_->getSearchContext();
+        auto& ctx = *ctx_ptr;
         if (STATISTICS_LEVEL >= 3) {
-            rst = index_->searchKnn(single_query, k, bitset, query_stats[i]);
+            index_->searchKnn(single_query, k, bitset, query_stats[i], ctx);
         } else {
             auto dummy_stat = hnswlib::StatisticsInfo();
-            rst = index_->searchKnn(single_query, k, bitset, dummy_stat);
+            index_->searchKnn(single_query, k, bitset, dummy_stat, ctx);
         }
+        auto& rst = ctx.result;
         size_t rst_size = rst.size();
 
         auto p_single_dis = p_dist + i * k;
         auto p_single_id = p_id + i * k;
-        size_t idx = rst_size - 1;
-        while (!rst.empty()) {
-            auto& it = rst.top();
-            p_single_dis[idx] = transform ? (1 - it.first) : it.first;
-            p_single_id[idx] = it.second;
-            rst.pop();
-            idx--;
+        for (size_t idx = 0; idx < rst_size; idx++) {
+            p_single_dis[idx] = transform ? (1 - rst[idx].first) : rst[idx].first;
+            p_single_id[idx] = rst[idx].second;
         }
         MapOffsetToUid(p_single_id, rst_size);
 
-        for (idx = rst_size; idx < k; idx++) {
+        for (size_t idx = rst_size; idx < k; idx++) {
             p_single_dis[idx] = float(1.0 / 0.0);
             p_single_id[idx] = -1;
         }
@@ -60,12 +60,18 @@ IVF_NM::Serialize(const Config& config) {
 
 void
 IVF_NM::Load(const BinarySet& binary_set) {
-    Assemble(const_cast<BinarySet&>(binary_set));
+    // raw data is gathered into arranged order straight from its slices
+    Assemble(const_cast<BinarySet&>(binary_set), {RAW_DATA});
     LoadImpl(binary_set, index_type_);
 
     // Construct arranged data from original data
-    auto binary = binary_set.GetByName(RAW_DATA);
-    auto original_data = reinterpret_cast<const float*>(binary->data.get());
+    auto raw_slices = GetSlices(binary_set, RAW_DATA);
+    std::vector<int64_t> raw_offsets;
+    int64_t raw_size = 0;
+    for (auto& slice : raw_slices) {
+        raw_offsets.push_back(raw_size);
+        raw_size += slice->size;
+    }
     auto ivf_index = static_cast<faiss::IndexIVF*>(index_.get());
     auto invlists = ivf_index->invlists;
     auto d = ivf_index->d;
@@ -78,12 +84,13 @@ IVF_NM::Load(const BinarySet& binary_set) {
 
 #ifndef MILVUS_GPU_VERSION
     auto ails = dynamic_cast<faiss::ArrayInvertedLists*>(invlists);
-    size_t nb = binary->size / invlists->code_size;
+    size_t nb = raw_size / invlists->code_size;
     auto arranged_data = new float[d * nb];
     for (size_t i = 0; i < invlists->nlist; i++) {
         auto list_size = ails->ids[i].size();
         for (size_t j = 0; j < list_size; j++) {
-            memcpy(arranged_data + d * (curr_index + j), original_data + d * ails->ids[i][j], d * sizeof(float));
+            CopyFromSlices(raw_slices, raw_offsets, d * sizeof(float) * ails->ids[i][j], d * sizeof(float),
+                           reinterpret_cast<uint8_t*>(arranged_data + d * (curr_index + j)));
         }
         prefix_sum[i] = curr_index;
         curr_index += list_size;
@@ -97,8 +104,8 @@ IVF_NM::Load(const BinarySet& binary_set) {
     for (size_t i = 0; i < invlists->nlist; i++) {
         auto list_size = lengths[i];
         for (size_t j = 0; j < list_size; j++) {
-            memcpy(arranged_data + d * (curr_index + j), original_data + d * rol_ids[curr_index + j],
-                   d * sizeof(float));
+            CopyFromSlices(raw_slices, raw_offsets, d * sizeof(float) * rol_ids[curr_index + j], d * sizeof(float),
+                           reinterpret_cast<uint8_t*>(arranged_data + d * (curr_index + j)));
         }
         prefix_sum[i] = curr_index;
         curr_index += list_size;
@@ -9,6 +9,7 @@
 #include <faiss/impl/ScalarQuantizerDC.h>
 #include <faiss/impl/ScalarQuantizerDC_avx.h>
 #include <faiss/impl/ScalarQuantizerDC_avx512.h>
+#include <faiss/utils/BinaryDistance.h>
 #include <faiss/utils/distances.h>
 #include <faiss/utils/distances_avx.h>
 #include <faiss/utils/distances_avx512.h>
@@ -30,6 +31,14 @@ sq_get_distance_computer_func_ptr sq_get_distance_computer = sq_get_distance_com
 sq_sel_quantizer_func_ptr sq_sel_quantizer = sq_select_quantizer_avx;
 sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
 
+/* set default to the portable versions, hook_init() picks the SIMD ones */
+popcnt_func_ptr popcnt = popcnt_ref;
+binary_int_func_ptr xor_popcnt = xor_popcnt_ref;
+binary_int_func_ptr or_popcnt = or_popcnt_ref;
+binary_int_func_ptr and_popcnt = and_popcnt_ref;
+binary_bool_func_ptr is_subset = is_subset_ref;
+binary_float_func_ptr bvec_jaccard = bvec_jaccard_ref;
+
 /*****************************************************************************/
 
 bool support_avx512() {
@@ -41,6 +50,13 @@ bool support_avx512() {
             instruction_set_inst.AVX512BW());
 }
 
+bool support_avx512_vpopcntdq() {
+    if (!support_avx512()) return false;
+
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.AVX512VPOPCNTDQ());
+}
+
 bool support_avx2() {
     if (!faiss_use_avx2) return false;
 
@@ -71,6 +87,22 @@ bool hook_init(std::string& cpu_flag) {
         sq_sel_quantizer = sq_select_quantizer_avx512;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx512;
 
+        /* for binary */
+        if (support_avx512_vpopcntdq()) {
+            popcnt = popcnt_AVX512VPOPCNTDQ;
+            xor_popcnt = xor_popcnt_AVX512VPOPCNTDQ;
+            or_popcnt = or_popcnt_AVX512VPOPCNTDQ;
+            and_popcnt = and_popcnt_AVX512VPOPCNTDQ;
+            bvec_jaccard = jaccard_AVX512VPOPCNTDQ;
+        } else {
+            popcnt = popcnt_AVX512VBMI_lookup;
+            xor_popcnt = xor_popcnt_AVX512VBMI_lookup;
+            or_popcnt = or_popcnt_AVX512VBMI_lookup;
+            and_popcnt = and_popcnt_AVX512VBMI_lookup;
+            bvec_jaccard = jaccard__AVX512;
+        }
+        is_subset = is_subset_AVX512;
+
         cpu_flag = "AVX512";
     } else if (support_avx2()) {
         /* for IVFFLAT */
@@ -84,6 +116,14 @@ bool hook_init(std::string& cpu_flag) {
         sq_sel_quantizer = sq_select_quantizer_avx;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
 
+        /* for binary */
+        popcnt = popcnt_AVX2;
+        xor_popcnt = xor_popcnt_AVX2;
+        or_popcnt = or_popcnt_AVX2;
+        and_popcnt = and_popcnt_AVX2;
+        is_subset = is_subset_AVX2;
+        bvec_jaccard = jaccard_AVX2;
+
         cpu_flag = "AVX2";
     } else if (support_sse()) {
         /* for IVFFLAT */
@@ -97,6 +137,14 @@ bool hook_init(std::string& cpu_flag) {
         sq_sel_quantizer = sq_select_quantizer_ref;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_ref;
 
+        /* for binary */
+        popcnt = popcnt_ref;
+        xor_popcnt = xor_popcnt_ref;
+        or_popcnt = or_popcnt_ref;
+        and_popcnt = and_popcnt_ref;
+        is_subset = is_subset_ref;
+        bvec_jaccard = bvec_jaccard_ref;
+
         cpu_flag = "SSE42";
     } else {
         cpu_flag = "UNSUPPORTED";
@@ -62,7 +62,7 @@ namespace faiss {
         } \
     }
 
-int popcnt(const uint8_t* data, const size_t code_size) {
+int popcnt_ref(const uint8_t* data, const size_t code_size) {
     auto data1 = data, data2 = data; // for the macro fast_loop_imp
 #define fun_u64 accu += popcount64(a[i])
 #define fun_u8(i) accu += lookup8bit[a[i]]
@@ -73,7 +73,7 @@ int popcnt(const uint8_t* data, const size_t code_size) {
 #undef fun_u8
 }
 
-int xor_popcnt(const uint8_t* data1, const uint8_t*data2, const size_t code_size) {
+int xor_popcnt_ref(const uint8_t* data1, const uint8_t*data2, const size_t code_size) {
 #define fun_u64 accu += popcount64(a[i] ^ b[i]);
 #define fun_u8(i) accu += lookup8bit[a[i] ^ b[i]];
     int accu = 0;
@@ -83,7 +83,7 @@ int xor_popcnt(const uint8_t* data1, const uint8_t*data2, const size_t code_size
 #undef fun_u8
 }
 
-int or_popcnt(const uint8_t* data1, const uint8_t*data2, const size_t code_size) {
+int or_popcnt_ref(const uint8_t* data1, const uint8_t*data2, const size_t code_size) {
 #define fun_u64 accu += popcount64(a[i] | b[i])
 #define fun_u8(i) accu += lookup8bit[a[i] | b[i]]
     int accu = 0;
@@ -93,7 +93,7 @@ int or_popcnt(const uint8_t* data1, const uint8_t*data2, const size_t code_size)
 #undef fun_u8
 }
 
-int and_popcnt(const uint8_t* data1, const uint8_t*data2, const size_t code_size) {
+int and_popcnt_ref(const uint8_t* data1, const uint8_t*data2, const size_t code_size) {
 #define fun_u64 accu += popcount64(a[i] & b[i])
 #define fun_u8(i) accu += lookup8bit[a[i] & b[i]]
     int accu = 0;
@@ -103,7 +103,7 @@ int and_popcnt(const uint8_t* data1, const uint8_t*data2, const size_t code_size
 #undef fun_u8
 }
 
-bool is_subset(const uint8_t* data1, const uint8_t* data2, const size_t code_size) {
+bool is_subset_ref(const uint8_t* data1, const uint8_t* data2, const size_t code_size) {
 #define fun_u64 if((a[i] & b[i]) != a[i]) return false
 #define fun_u8(i) if((a[i] & b[i]) != a[i]) return false
     fast_loop_imp(fun_u64, fun_u8);
@@ -112,7 +112,7 @@ bool is_subset(const uint8_t* data1, const uint8_t* data2, const size_t code_siz
 #undef fun_u8
 }
 
-float bvec_jaccard (const uint8_t* data1, const uint8_t* data2, const size_t code_size) {
+float bvec_jaccard_ref(const uint8_t* data1, const uint8_t* data2, const size_t code_size) {
 #define fun_u64 accu_num += popcount64(a[i] & b[i]); accu_den += popcount64(a[i] | b[i])
 #define fun_u8(i) accu_num += lookup8bit[a[i] & b[i]]; accu_den += lookup8bit[a[i] | b[i]]
     int accu_num = 0;
@@ -421,8 +421,8 @@ void binary_distance_knn_hc (
 {
     switch (metric_type) {
     case METRIC_Jaccard: {
-        if (support_avx2() && ncodes > 64) {
-            binary_distance_knn_hc<C, faiss::JaccardComputerAVX2>
+        if (ncodes > 64) {
+            binary_distance_knn_hc<C, faiss::JaccardComputerDefault>
                     (ncodes, ha, a, b, nb, bitset);
         } else {
             switch (ncodes) {
@@ -449,8 +449,8 @@ void binary_distance_knn_hc (
     }
 
     case METRIC_Hamming: {
-        if (support_avx2() && ncodes > 64) {
-            binary_distance_knn_hc<C, faiss::HammingComputerAVX2>
+        if (ncodes > 64) {
+            binary_distance_knn_hc<C, faiss::HammingComputerDefault>
                     (ncodes, ha, a, b, nb, bitset);
         } else {
             switch (ncodes) {
@@ -554,8 +554,8 @@ void binary_range_search(
     case METRIC_Tanimoto:
         radius = Tanimoto_2_Jaccard(radius);
     case METRIC_Jaccard: {
-        if (support_avx2() && ncodes > 64) {
-            binary_range_search<C, T, faiss::JaccardComputerAVX2>
+        if (ncodes > 64) {
+            binary_range_search<C, T, faiss::JaccardComputerDefault>
                     (a, b, na, nb, ncodes, radius, result, buffer_size, bitset);
         } else {
             switch (ncodes) {
@@ -592,8 +592,8 @@ void binary_range_search(
     }
 
     case METRIC_Hamming: {
-        if (support_avx2() && ncodes > 64) {
-            binary_range_search<C, T, faiss::HammingComputerAVX2>
+        if (ncodes > 64) {
+            binary_range_search<C, T, faiss::HammingComputerDefault>
                     (a, b, na, nb, ncodes, radius, result, buffer_size, bitset);
         } else {
             switch (ncodes) {
@@ -22,49 +22,72 @@
 typedef float tadis_t;
 
 namespace faiss {
+    typedef int (*binary_int_func_ptr)(const uint8_t*, const uint8_t*, const size_t);
+    typedef bool (*binary_bool_func_ptr)(const uint8_t*, const uint8_t*, const size_t);
+    typedef float (*binary_float_func_ptr)(const uint8_t*, const uint8_t*, const size_t);
+    typedef int (*popcnt_func_ptr)(const uint8_t*, const size_t);
+
+    /**
+     * The binary kernels below are hooked, hook_init() points them to
+     * the widest implementation supported by the cpu, the _ref versions
+     * are the portable fallbacks.
+     */
+
     /**
      * Calculate the number of bit 1
      */
-    extern int popcnt(
-            const uint8_t* data,
-            const size_t code_size);
+    extern popcnt_func_ptr popcnt;
 
     /**
      * Calculate the number of bit 1 after xor
      */
-    extern int xor_popcnt(
-            const uint8_t* data1,
-            const uint8_t* data2,
-            const size_t code_size);
+    extern binary_int_func_ptr xor_popcnt;
 
     /**
      * Calculate the number of bit 1 after or
      */
-    extern int or_popcnt(
-            const uint8_t* data1,
-            const uint8_t* data2,
-            const size_t code_size);
+    extern binary_int_func_ptr or_popcnt;
 
     /**
      * Calculate the number of bit 1 after and
      */
-    extern int and_popcnt(
-            const uint8_t* data1,
-            const uint8_t* data2,
-            const size_t code_size);
+    extern binary_int_func_ptr and_popcnt;
 
     /**
      * Judge whether data1 is a subset of data2
      */
-    extern bool is_subset(
-            const uint8_t* data1,
-            const uint8_t* data2,
-            const size_t code_size);
+    extern binary_bool_func_ptr is_subset;
 
     /**
      * Calculate Jaccard distance
      */
-    extern float bvec_jaccard (
+    extern binary_float_func_ptr bvec_jaccard;
+
+    int popcnt_ref(
+            const uint8_t* data,
+            const size_t code_size);
+
+    int xor_popcnt_ref(
+            const uint8_t* data1,
+            const uint8_t* data2,
+            const size_t code_size);
+
+    int or_popcnt_ref(
+            const uint8_t* data1,
+            const uint8_t* data2,
+            const size_t code_size);
+
+    int and_popcnt_ref(
+            const uint8_t* data1,
+            const uint8_t* data2,
+            const size_t code_size);
+
+    bool is_subset_ref(
+            const uint8_t* data1,
+            const uint8_t* data2,
+            const size_t code_size);
+
+    float bvec_jaccard_ref(
             const uint8_t* data1,
             const uint8_t* data2,
             const size_t code_size);
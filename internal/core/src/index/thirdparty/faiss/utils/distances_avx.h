@@ -48,4 +48,24 @@ popcnt_AVX2_lookup(const uint8_t* data, const size_t n);
 float
 jaccard__AVX2(const uint8_t * a, const uint8_t * b, size_t n);
 
+/// Harley-Seal popcount
+int
+popcnt_AVX2(const uint8_t* data, const size_t n);
+
+int
+xor_popcnt_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
+int
+or_popcnt_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
+int
+and_popcnt_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
+bool
+is_subset_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
+/// and/or counted in a single pass
+float
+jaccard_AVX2(const uint8_t* a, const uint8_t* b, const size_t n);
+
 } // namespace faiss
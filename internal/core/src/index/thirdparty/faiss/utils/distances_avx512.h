@@ -47,4 +47,24 @@ and_popcnt_AVX512VBMI_lookup(const uint8_t* data1, const uint8_t* data2, const s
 float
 jaccard__AVX512(const uint8_t * a, const uint8_t * b, size_t n);
 
+/// native popcount, needs AVX512 VPOPCNTDQ
+int
+popcnt_AVX512VPOPCNTDQ(const uint8_t* data, const size_t n);
+
+int
+xor_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
+int
+or_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
+int
+and_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
+/// and/or counted in a single pass
+float
+jaccard_AVX512VPOPCNTDQ(const uint8_t* a, const uint8_t* b, const size_t n);
+
+bool
+is_subset_AVX512(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
 } // namespace faiss
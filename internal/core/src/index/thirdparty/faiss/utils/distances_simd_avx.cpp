@@ -480,6 +480,193 @@ jaccard__AVX2(const uint8_t * a, const uint8_t * b, size_t n) {
     return (accu_den == 0) ? 1.0 : ((float)(accu_den - accu_num) / (float)(accu_den));
 }
 
+
+/*********************************************************
+ * Harley-Seal popcount, 16 vectors are folded by carry-save
+ * adders so only one vector in 16 goes through the lookup
+ *********************************************************/
+
+static inline __m256i
+popcount256_lookup(__m256i vec) {
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_and_si256(vec, low_mask);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(vec, 4), low_mask);
+    const __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+static inline void
+CSA256(__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c) {
+    const __m256i u = _mm256_xor_si256(a, b);
+    h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    l = _mm256_xor_si256(u, c);
+}
+
+struct PopcntOp {
+    __m256i operator()(__m256i a, __m256i) const { return a; }
+    uint8_t operator()(uint8_t a, uint8_t) const { return a; }
+};
+
+struct XorOp {
+    __m256i operator()(__m256i a, __m256i b) const { return _mm256_xor_si256(a, b); }
+    uint8_t operator()(uint8_t a, uint8_t b) const { return a ^ b; }
+};
+
+struct OrOp {
+    __m256i operator()(__m256i a, __m256i b) const { return _mm256_or_si256(a, b); }
+    uint8_t operator()(uint8_t a, uint8_t b) const { return a | b; }
+};
+
+struct AndOp {
+    __m256i operator()(__m256i a, __m256i b) const { return _mm256_and_si256(a, b); }
+    uint8_t operator()(uint8_t a, uint8_t b) const { return a & b; }
+};
+
+template <typename Op>
+static inline int
+harley_seal_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n, Op op) {
+#define LOAD(k) op(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data1 + i + (k) * 32)), \
+                   _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data2 + i + (k) * 32)))
+
+    size_t i = 0;
+    __m256i total = _mm256_setzero_si256();
+    __m256i ones = _mm256_setzero_si256();
+    __m256i twos = _mm256_setzero_si256();
+    __m256i fours = _mm256_setzero_si256();
+    __m256i eights = _mm256_setzero_si256();
+    __m256i sixteens, twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+
+    for (; i + 16 * 32 <= n; i += 16 * 32) {
+        CSA256(twos_a, ones, ones, LOAD(0), LOAD(1));
+        CSA256(twos_b, ones, ones, LOAD(2), LOAD(3));
+        CSA256(fours_a, twos, twos, twos_a, twos_b);
+        CSA256(twos_a, ones, ones, LOAD(4), LOAD(5));
+        CSA256(twos_b, ones, ones, LOAD(6), LOAD(7));
+        CSA256(fours_b, twos, twos, twos_a, twos_b);
+        CSA256(eights_a, fours, fours, fours_a, fours_b);
+        CSA256(twos_a, ones, ones, LOAD(8), LOAD(9));
+        CSA256(twos_b, ones, ones, LOAD(10), LOAD(11));
+        CSA256(fours_a, twos, twos, twos_a, twos_b);
+        CSA256(twos_a, ones, ones, LOAD(12), LOAD(13));
+        CSA256(twos_b, ones, ones, LOAD(14), LOAD(15));
+        CSA256(fours_b, twos, twos, twos_a, twos_b);
+        CSA256(eights_b, fours, fours, fours_a, fours_b);
+        CSA256(sixteens, eights, eights, eights_a, eights_b);
+        total = _mm256_add_epi64(total, popcount256_lookup(sixteens));
+    }
+
+    total = _mm256_slli_epi64(total, 4);
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256_lookup(eights), 3));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256_lookup(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256_lookup(twos), 1));
+    total = _mm256_add_epi64(total, popcount256_lookup(ones));
+
+    for (; i + 32 <= n; i += 32) {
+        total = _mm256_add_epi64(total, popcount256_lookup(LOAD(0)));
+    }
+
+#undef LOAD
+
+    int result = 0;
+
+    result += static_cast<uint64_t>(_mm256_extract_epi64(total, 0));
+    result += static_cast<uint64_t>(_mm256_extract_epi64(total, 1));
+    result += static_cast<uint64_t>(_mm256_extract_epi64(total, 2));
+    result += static_cast<uint64_t>(_mm256_extract_epi64(total, 3));
+
+    for (/**/; i < n; i++) {
+        result += lookup8bit[op(data1[i], data2[i])];
+    }
+
+    return result;
+}
+
+int
+popcnt_AVX2(const uint8_t* data, const size_t n) {
+    return harley_seal_AVX2(data, data, n, PopcntOp());
+}
+
+int
+xor_popcnt_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    return harley_seal_AVX2(data1, data2, n, XorOp());
+}
+
+int
+or_popcnt_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    return harley_seal_AVX2(data1, data2, n, OrOp());
+}
+
+int
+and_popcnt_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    return harley_seal_AVX2(data1, data2, n, AndOp());
+}
+
+bool
+is_subset_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data1 + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data2 + i));
+        // (~b & a) == 0
+        if (!_mm256_testc_si256(b, a)) {
+            return false;
+        }
+    }
+    for (/**/; i < n; i++) {
+        if ((data1[i] & data2[i]) != data1[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float
+jaccard_AVX2(const uint8_t* a, const uint8_t* b, const size_t n) {
+    // a & b and a | b are counted in one pass over the codes
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    size_t i = 0;
+    __m256i acc_num = _mm256_setzero_si256();
+    __m256i acc_den = _mm256_setzero_si256();
+
+    // 8 iterations of at most 8 per byte never overflow the byte counters
+    while (i + 32 <= n) {
+        __m256i local_num = _mm256_setzero_si256();
+        __m256i local_den = _mm256_setzero_si256();
+        for (int k = 0; k < 8 && i + 32 <= n; k++, i += 32) {
+            const __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            const __m256i v_and = _mm256_and_si256(s1, s2);
+            const __m256i v_or = _mm256_or_si256(s1, s2);
+            local_num = _mm256_add_epi8(local_num, _mm256_shuffle_epi8(lookup, _mm256_and_si256(v_and, low_mask)));
+            local_num = _mm256_add_epi8(
+                local_num, _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v_and, 4), low_mask)));
+            local_den = _mm256_add_epi8(local_den, _mm256_shuffle_epi8(lookup, _mm256_and_si256(v_or, low_mask)));
+            local_den = _mm256_add_epi8(
+                local_den, _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v_or, 4), low_mask)));
+        }
+        acc_num = _mm256_add_epi64(acc_num, _mm256_sad_epu8(local_num, _mm256_setzero_si256()));
+        acc_den = _mm256_add_epi64(acc_den, _mm256_sad_epu8(local_den, _mm256_setzero_si256()));
+    }
+
+    int accu_num = 0;
+    int accu_den = 0;
+    accu_num += static_cast<uint64_t>(_mm256_extract_epi64(acc_num, 0));
+    accu_num += static_cast<uint64_t>(_mm256_extract_epi64(acc_num, 1));
+    accu_num += static_cast<uint64_t>(_mm256_extract_epi64(acc_num, 2));
+    accu_num += static_cast<uint64_t>(_mm256_extract_epi64(acc_num, 3));
+    accu_den += static_cast<uint64_t>(_mm256_extract_epi64(acc_den, 0));
+    accu_den += static_cast<uint64_t>(_mm256_extract_epi64(acc_den, 1));
+    accu_den += static_cast<uint64_t>(_mm256_extract_epi64(acc_den, 2));
+    accu_den += static_cast<uint64_t>(_mm256_extract_epi64(acc_den, 3));
+
+    for (/**/; i < n; i++) {
+        accu_num += lookup8bit[a[i] & b[i]];
+        accu_den += lookup8bit[a[i] | b[i]];
+    }
+
+    return (accu_den == 0) ? 1.0 : ((float)(accu_den - accu_num) / (float)(accu_den));
+}
+
 #else
 
 float fvec_inner_product_avx(const float* x, const float* y, size_t d) {
@@ -502,6 +689,42 @@ float fvec_Linf_avx (const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+int
+popcnt_AVX2(const uint8_t* data, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+xor_popcnt_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+or_popcnt_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+and_popcnt_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+bool
+is_subset_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return false;
+}
+
+float
+jaccard_AVX2(const uint8_t* a, const uint8_t* b, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
 #endif
 
 } // namespace faiss
@@ -252,11 +252,11 @@ popcnt_AVX512VBMI_lookup(const uint8_t* data, const size_t n) {
 
     __m512i acc = _mm512_setzero_si512();
 
-    while (i + 64 < n) {
+    while (i + 64 <= n) {
 
         __m512i local = _mm512_setzero_si512();
 
-        for (int k=0; k < 255/8 && i + 64 < n; k++, i += 64) {
+        for (int k=0; k < 255/8 && i + 64 <= n; k++, i += 64) {
             const __m512i vec = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(data + i));
             const __m512i lo  = _mm512_and_si512(vec, low_mask);
             const __m512i hi  = _mm512_and_si512(_mm512_srli_epi32(vec, 4), low_mask);
@@ -296,11 +296,11 @@ xor_popcnt_AVX512VBMI_lookup(const uint8_t* data1, const uint8_t* data2, const s
 
     __m512i acc = _mm512_setzero_si512();
 
-    while (i + 64 < n) {
+    while (i + 64 <= n) {
 
         __m512i local = _mm512_setzero_si512();
 
-        for (int k=0; k < 255/8 && i + 64 < n; k++, i += 64) {
+        for (int k=0; k < 255/8 && i + 64 <= n; k++, i += 64) {
             const __m512i s1 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(data1 + i));
             const __m512i s2 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(data2 + i));
             const __m512i vec = _mm512_xor_si512(s1, s2);
@@ -342,11 +342,11 @@ or_popcnt_AVX512VBMI_lookup(const uint8_t* data1, const uint8_t* data2, const si
 
     __m512i acc = _mm512_setzero_si512();
 
-    while (i + 64 < n) {
+    while (i + 64 <= n) {
 
         __m512i local = _mm512_setzero_si512();
 
-        for (int k=0; k < 255/8 && i + 64 < n; k++, i += 64) {
+        for (int k=0; k < 255/8 && i + 64 <= n; k++, i += 64) {
             const __m512i s1 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(data1 + i));
             const __m512i s2 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(data2 + i));
             const __m512i vec = _mm512_or_si512(s1, s2);
@@ -388,11 +388,11 @@ and_popcnt_AVX512VBMI_lookup(const uint8_t* data1, const uint8_t* data2, const s
 
     __m512i acc = _mm512_setzero_si512();
 
-    while (i + 64 < n) {
+    while (i + 64 <= n) {
 
         __m512i local = _mm512_setzero_si512();
 
-        for (int k=0; k < 255/8 && i + 64 < n; k++, i += 64) {
+        for (int k=0; k < 255/8 && i + 64 <= n; k++, i += 64) {
             const __m512i s1 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(data1 + i));
             const __m512i s2 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(data2 + i));
             const __m512i vec = _mm512_and_si512(s1, s2);
@@ -425,6 +425,105 @@ jaccard__AVX512(const uint8_t * a, const uint8_t * b, size_t n) {
     return (accu_den == 0) ? 1.0 : ((float)(accu_den - accu_num) / (float)(accu_den));
 }
 
+
+/*********************************************************
+ * AVX512 VPOPCNTDQ, a native 64-bit lane popcount, the tail
+ * is read by a masked load instead of a scalar loop
+ *********************************************************/
+
+struct PopcntOp512 {
+    __m512i operator()(__m512i a, __m512i) const { return a; }
+};
+
+struct XorOp512 {
+    __m512i operator()(__m512i a, __m512i b) const { return _mm512_xor_si512(a, b); }
+};
+
+struct OrOp512 {
+    __m512i operator()(__m512i a, __m512i b) const { return _mm512_or_si512(a, b); }
+};
+
+struct AndOp512 {
+    __m512i operator()(__m512i a, __m512i b) const { return _mm512_and_si512(a, b); }
+};
+
+// op of two zero vectors must be zero, the masked tail relies on it
+template <typename Op>
+__attribute__((target("avx512vpopcntdq"))) static int
+vpopcnt_AVX512(const uint8_t* data1, const uint8_t* data2, const size_t n, Op op) {
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 128 <= n; i += 128) {
+        const __m512i v0 = op(_mm512_loadu_si512(data1 + i), _mm512_loadu_si512(data2 + i));
+        const __m512i v1 = op(_mm512_loadu_si512(data1 + i + 64), _mm512_loadu_si512(data2 + i + 64));
+        acc0 = _mm512_add_epi64(acc0, _mm512_popcnt_epi64(v0));
+        acc1 = _mm512_add_epi64(acc1, _mm512_popcnt_epi64(v1));
+    }
+    if (i + 64 <= n) {
+        const __m512i v = op(_mm512_loadu_si512(data1 + i), _mm512_loadu_si512(data2 + i));
+        acc0 = _mm512_add_epi64(acc0, _mm512_popcnt_epi64(v));
+        i += 64;
+    }
+    if (i < n) {
+        const __mmask64 mask = (1ULL << (n - i)) - 1;
+        const __m512i v = op(_mm512_maskz_loadu_epi8(mask, data1 + i), _mm512_maskz_loadu_epi8(mask, data2 + i));
+        acc1 = _mm512_add_epi64(acc1, _mm512_popcnt_epi64(v));
+    }
+    return _mm512_reduce_add_epi64(_mm512_add_epi64(acc0, acc1));
+}
+
+int
+popcnt_AVX512VPOPCNTDQ(const uint8_t* data, const size_t n) {
+    return vpopcnt_AVX512(data, data, n, PopcntOp512());
+}
+
+int
+xor_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    return vpopcnt_AVX512(data1, data2, n, XorOp512());
+}
+
+int
+or_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    return vpopcnt_AVX512(data1, data2, n, OrOp512());
+}
+
+int
+and_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    return vpopcnt_AVX512(data1, data2, n, AndOp512());
+}
+
+__attribute__((target("avx512vpopcntdq"))) float
+jaccard_AVX512VPOPCNTDQ(const uint8_t* a, const uint8_t* b, const size_t n) {
+    // a & b and a | b are counted in one pass over the codes
+    __m512i acc_num = _mm512_setzero_si512();
+    __m512i acc_den = _mm512_setzero_si512();
+    for (size_t i = 0; i < n; i += 64) {
+        const __mmask64 mask = (i + 64 <= n) ? ~0ULL : (1ULL << (n - i)) - 1;
+        const __m512i s1 = _mm512_maskz_loadu_epi8(mask, a + i);
+        const __m512i s2 = _mm512_maskz_loadu_epi8(mask, b + i);
+        acc_num = _mm512_add_epi64(acc_num, _mm512_popcnt_epi64(_mm512_and_si512(s1, s2)));
+        acc_den = _mm512_add_epi64(acc_den, _mm512_popcnt_epi64(_mm512_or_si512(s1, s2)));
+    }
+    int accu_num = _mm512_reduce_add_epi64(acc_num);
+    int accu_den = _mm512_reduce_add_epi64(acc_den);
+    return (accu_den == 0) ? 1.0 : ((float)(accu_den - accu_num) / (float)(accu_den));
+}
+
+bool
+is_subset_AVX512(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    for (size_t i = 0; i < n; i += 64) {
+        const __mmask64 mask = (i + 64 <= n) ? ~0ULL : (1ULL << (n - i)) - 1;
+        const __m512i a = _mm512_maskz_loadu_epi8(mask, data1 + i);
+        const __m512i b = _mm512_maskz_loadu_epi8(mask, data2 + i);
+        // bytes where a has a bit that b lacks
+        if (_mm512_test_epi8_mask(_mm512_andnot_si512(b, a), _mm512_andnot_si512(b, a)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 #else
 
 float
@@ -451,6 +550,42 @@ fvec_Linf_avx512(const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+int
+popcnt_AVX512VPOPCNTDQ(const uint8_t* data, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+xor_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+or_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+and_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+float
+jaccard_AVX512VPOPCNTDQ(const uint8_t* a, const uint8_t* b, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+bool
+is_subset_AVX512(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return false;
+}
+
 #endif
 
 } // namespace faiss
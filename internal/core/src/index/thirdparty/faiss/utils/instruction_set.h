@@ -289,6 +289,11 @@ class InstructionSet {
         return f_7_ECX_[0];
     }
 
+    bool
+    AVX512VPOPCNTDQ(void) {
+        return f_7_ECX_[14];
+    }
+
     bool
     LAHF(void) {
         return f_81_ECX_[0];
@@ -6,6 +6,10 @@
 #include <stdlib.h>
 #include <unordered_set>
 #include <list>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
 
@@ -14,6 +18,38 @@ namespace hnswlib {
 typedef unsigned int tableint;
 typedef unsigned int linklistsizeint;
 
+// binary heap on a vector kept across searches, pops in the same order as std::priority_queue
+template<typename T, typename Compare>
+class ReusableHeap {
+ public:
+    bool empty() const { return data_.empty(); }
+    size_t size() const { return data_.size(); }
+    const T &top() const { return data_.front(); }
+
+    template<typename... Args>
+    void emplace(Args &&... args) {
+        data_.emplace_back(std::forward<Args>(args)...);
+        std::push_heap(data_.begin(), data_.end(), comp_);
+    }
+
+    void pop() {
+        std::pop_heap(data_.begin(), data_.end(), comp_);
+        data_.pop_back();
+    }
+
+    void clear() { data_.clear(); }
+
+    // sort the elements in ascending order, the heap must be cleared before it is reused
+    const std::vector<T> &sorted() {
+        std::sort_heap(data_.begin(), data_.end(), comp_);
+        return data_;
+    }
+
+ private:
+    std::vector<T> data_;
+    Compare comp_;
+};
+
 
 template<typename dist_t>
 class HierarchicalNSW : public AlgorithmInterface<dist_t> {
@@ -87,6 +123,91 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         }
     };
 
+    // buffers of searchKnn, reused by the searches of this index instead of allocated per query
+    struct SearchContext {
+        ReusableHeap<std::pair<dist_t, tableint>, CompareByFirst> top_candidates;
+        ReusableHeap<std::pair<dist_t, tableint>, CompareByFirst> candidate_set;
+        // epoch tagged, reset() only bumps the tag
+        std::unique_ptr<VisitedList> visited_list;
+        // sorted by ascending distance
+        std::vector<std::pair<dist_t, labeltype>> result;
+
+        VisitedList *getVisitedList(size_t num_elements) {
+            // a context belongs to one index, so the list only grows when the index is resized
+            if (visited_list == nullptr || visited_list->numelements < num_elements) {
+                visited_list.reset();
+                visited_list = std::make_unique<VisitedList>(num_elements);
+            }
+            visited_list->reset();
+            return visited_list.get();
+        }
+    };
+
+    // search contexts of an index, taken and given back with an atomic exchange instead of a lock.
+    // a thread starts probing at its own slot, so concurrent searches rarely meet on one
+    class SearchContextPool {
+     public:
+        SearchContextPool() : num_slots_(std::max(1u, std::thread::hardware_concurrency())),
+                              slots_(new std::atomic<SearchContext *>[num_slots_]) {
+            for (size_t i = 0; i < num_slots_; i++) {
+                slots_[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        ~SearchContextPool() {
+            for (size_t i = 0; i < num_slots_; i++) {
+                delete slots_[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        SearchContext *acquire() {
+            auto first = std::hash<std::thread::id>()(std::this_thread::get_id());
+            for (size_t i = 0; i < num_slots_; i++) {
+                auto ctx = slots_[(first + i) % num_slots_].exchange(nullptr, std::memory_order_acquire);
+                if (ctx != nullptr) {
+                    return ctx;
+                }
+            }
+            num_contexts_.fetch_add(1, std::memory_order_relaxed);
+            return new SearchContext();
+        }
+
+        void release(SearchContext *ctx) {
+            auto first = std::hash<std::thread::id>()(std::this_thread::get_id());
+            for (size_t i = 0; i < num_slots_; i++) {
+                SearchContext *expected = nullptr;
+                if (slots_[(first + i) % num_slots_].compare_exchange_strong(expected, ctx, std::memory_order_release,
+                                                                             std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+            // more concurrent searches than slots, the extra context is dropped
+            num_contexts_.fetch_sub(1, std::memory_order_relaxed);
+            delete ctx;
+        }
+
+        // contexts alive, pooled or in use
+        size_t size() const {
+            return num_contexts_.load(std::memory_order_relaxed);
+        }
+
+     private:
+        size_t num_slots_;
+        std::unique_ptr<std::atomic<SearchContext *>[]> slots_;
+        std::atomic<size_t> num_contexts_{0};
+    };
+
+    struct SearchContextReleaser {
+        SearchContextPool *pool;
+        void operator()(SearchContext *ctx) const { pool->release(ctx); }
+    };
+    using SearchContextPtr = std::unique_ptr<SearchContext, SearchContextReleaser>;
+
+    // a context of this index, given back to its pool when the pointer is dropped
+    SearchContextPtr getSearchContext() const {
+        return SearchContextPtr(search_contexts_.acquire(), SearchContextReleaser{&search_contexts_});
+    }
+
     ~HierarchicalNSW() {
 
         free(data_level0_memory_);
@@ -120,6 +241,7 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
 
     VisitedListPool *visited_list_pool_;
+    mutable SearchContextPool search_contexts_;
     std::mutex cur_element_count_guard_;
 
     std::vector<std::mutex> link_list_locks_;
@@ -230,15 +352,19 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         return top_candidates;
     }
 
+    // the ef nearest candidates are left in ctx.top_candidates
     template <bool has_deletions>
-    std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-    searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef, const faiss::BitsetView bitset, StatisticsInfo &stats) const {
-        VisitedList *vl = visited_list_pool_->getFreeVisitedList();
+    void
+    searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef, const faiss::BitsetView bitset, StatisticsInfo &stats,
+                      SearchContext &ctx) const {
+        VisitedList *vl = ctx.getVisitedList(max_elements_);
         vl_type *visited_array = vl->mass;
         vl_type visited_array_tag = vl->curV;
 
-        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
-        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> candidate_set;
+        auto &top_candidates = ctx.top_candidates;
+        auto &candidate_set = ctx.candidate_set;
+        top_candidates.clear();
+        candidate_set.clear();
 
         dist_t lowerBound;
 //        if (!has_deletions || !isMarkedDeleted(ep_id)) {
@@ -313,8 +439,6 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
             }
         }
 
-        visited_list_pool_->releaseVisitedList(vl);
-        return top_candidates;
     }
 
     std::vector<tableint>
@@ -896,8 +1020,21 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
     std::priority_queue<std::pair<dist_t, labeltype >>
     searchKnn(const void *query_data, size_t k, const faiss::BitsetView bitset, StatisticsInfo &stats) const {
+        auto ctx = getSearchContext();
+        searchKnn(query_data, k, bitset, stats, *ctx);
         std::priority_queue<std::pair<dist_t, labeltype >> result;
-        if (cur_element_count == 0) return result;
+        for (auto &rez : ctx->result) {
+            result.push(rez);
+        }
+        return result;
+    };
+
+    // the k nearest neighbors are left in ctx.result, sorted by ascending distance
+    void
+    searchKnn(const void *query_data, size_t k, const faiss::BitsetView bitset, StatisticsInfo &stats,
+              SearchContext &ctx) const {
+        ctx.result.clear();
+        if (cur_element_count == 0) return;
 
         tableint currObj = enterpoint_node_;
         dist_t curdist = fstdistfunc_(query_data, getDataByInternalId(enterpoint_node_), dist_func_param_);
@@ -929,26 +1066,20 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
             }
         }
 
-        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
         if (!bitset.empty()) {
-            std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-                top_candidates1 = searchBaseLayerST<true>(currObj, query_data, std::max(ef_, k), bitset, stats);
-            top_candidates.swap(top_candidates1);
+            searchBaseLayerST<true>(currObj, query_data, std::max(ef_, k), bitset, stats, ctx);
         }
         else{
-            std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-                top_candidates1 = searchBaseLayerST<false>(currObj, query_data, std::max(ef_, k), bitset, stats);
-            top_candidates.swap(top_candidates1);
+            searchBaseLayerST<false>(currObj, query_data, std::max(ef_, k), bitset, stats, ctx);
         }
+        auto &top_candidates = ctx.top_candidates;
         while (top_candidates.size() > k) {
             top_candidates.pop();
         }
-        while (top_candidates.size() > 0) {
-            std::pair<dist_t, tableint> rez = top_candidates.top();
-            result.push(std::pair<dist_t, labeltype>(rez.first, rez.second));
-            top_candidates.pop();
+        for (auto &rez : top_candidates.sorted()) {
+            ctx.result.emplace_back(rez.first, rez.second);
         }
-        return result;
+        top_candidates.clear();
     };
 
     int64_t cal_size() {
@@ -956,6 +1087,8 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         ret += sizeof(*this);
         ret += sizeof(*space);
         ret += visited_list_pool_->GetSize();
+        // the heaps and results of a context are bounded by ef, its visited list is the bulk
+        ret += search_contexts_.size() * (sizeof(SearchContext) + sizeof(VisitedList) + max_elements_ * sizeof(vl_type));
         ret += link_list_locks_.size() * sizeof(std::mutex);
         ret += element_levels_.size() * sizeof(int);
         ret += max_elements_ * size_data_per_element_;
@@ -15,6 +15,10 @@
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 
+#include <faiss/FaissHook.h>
+#include <faiss/utils/BinaryDistance.h>
+#include <random>
+
 #include "Helper.h"
 #include "unittest/utils.h"
 
@@ -366,3 +370,30 @@ TEST_P(BinaryIDMAPTest, binaryidmap_range_search) {
         }
     }
 }
+
+TEST(BinaryDistanceTest, hooked_kernels_match_ref) {
+    std::string cpu_flag;
+    faiss::hook_init(cpu_flag);
+
+    std::mt19937 e(42);
+    // odd sizes cover the scalar and masked tails
+    for (size_t code_size : {1, 7, 8, 31, 32, 63, 64, 65, 127, 128, 255, 256, 511, 512, 513, 1024, 1031}) {
+        std::vector<uint8_t> a(code_size), b(code_size), c(code_size);
+        for (size_t i = 0; i < code_size; ++i) {
+            a[i] = e();
+            b[i] = e();
+            c[i] = a[i] & b[i];
+        }
+        ASSERT_EQ(faiss::popcnt(a.data(), code_size), faiss::popcnt_ref(a.data(), code_size));
+        ASSERT_EQ(faiss::xor_popcnt(a.data(), b.data(), code_size),
+                  faiss::xor_popcnt_ref(a.data(), b.data(), code_size));
+        ASSERT_EQ(faiss::or_popcnt(a.data(), b.data(), code_size), faiss::or_popcnt_ref(a.data(), b.data(), code_size));
+        ASSERT_EQ(faiss::and_popcnt(a.data(), b.data(), code_size),
+                  faiss::and_popcnt_ref(a.data(), b.data(), code_size));
+        ASSERT_EQ(faiss::bvec_jaccard(a.data(), b.data(), code_size),
+                  faiss::bvec_jaccard_ref(a.data(), b.data(), code_size));
+        ASSERT_EQ(faiss::is_subset(a.data(), b.data(), code_size), faiss::is_subset_ref(a.data(), b.data(), code_size));
+        ASSERT_TRUE(faiss::is_subset(c.data(), a.data(), code_size));
+        ASSERT_TRUE(faiss::is_subset(c.data(), b.data(), code_size));
+    }
+}
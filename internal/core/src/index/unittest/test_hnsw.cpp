@@ -12,7 +12,9 @@
 #include <gtest/gtest.h>
 #include "knowhere/common/Config.h"
 #include "knowhere/index/vector_index/IndexHNSW.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include "knowhere/common/Exception.h"
@@ -148,6 +150,63 @@ TEST_P(HNSWTest, HNSW_delete) {
     */
 }
 
+TEST_P(HNSWTest, HNSW_reuse_search_context) {
+    assert(!xb.empty());
+
+    index_->Train(base_dataset, conf);
+    index_->AddWithoutIds(base_dataset, conf);
+    auto result1 = index_->Query(query_dataset, conf, nullptr);
+    AssertAnns(result1, nq, k);
+
+    // a smaller index searched in between has search contexts of its own
+    auto small_index = std::make_shared<milvus::knowhere::IndexHNSW>();
+    auto small_dataset = milvus::knowhere::GenDataset(nq, dim, xb.data());
+    small_index->Train(small_dataset, conf);
+    small_index->AddWithoutIds(small_dataset, conf);
+    auto small_result = small_index->Query(query_dataset, conf, nullptr);
+    AssertAnns(small_result, nq, k);
+
+    auto result2 = index_->Query(query_dataset, conf, nullptr);
+    auto ids1 = result1->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto ids2 = result2->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto dist1 = result1->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    auto dist2 = result2->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq * k; i++) {
+        ASSERT_EQ(ids1[i], ids2[i]);
+        ASSERT_EQ(dist1[i], dist2[i]);
+    }
+}
+
+TEST_P(HNSWTest, HNSW_search_context_pool) {
+    assert(!xb.empty());
+
+    auto space = new hnswlib::L2Space(dim);
+    hnswlib::HierarchicalNSW<float> hnsw(space, nb);
+    for (int64_t i = 0; i < nb; i++) {
+        hnsw.addPoint(xb.data() + i * dim, i);
+    }
+    auto size_before = hnsw.cal_size();
+
+    // contexts in use at the same time are distinct, and given back ones are reused
+    std::vector<hnswlib::HierarchicalNSW<float>::SearchContext*> released;
+    {
+        auto ctx1 = hnsw.getSearchContext();
+        auto ctx2 = hnsw.getSearchContext();
+        ASSERT_NE(ctx1.get(), ctx2.get());
+        released = {ctx1.get(), ctx2.get()};
+    }
+    auto ctx = hnsw.getSearchContext();
+    ASSERT_NE(std::find(released.begin(), released.end(), ctx.get()), released.end());
+    auto stats = hnswlib::StatisticsInfo();
+    hnsw.searchKnn(xb.data(), k, faiss::BitsetView(), stats, *ctx);
+    ASSERT_EQ(int64_t(ctx->result.size()), k);
+    ASSERT_EQ(ctx->result[0].second, 0);
+    ASSERT_GE(int64_t(ctx->visited_list->numelements), nb);
+
+    // the pooled visited lists are part of the index size
+    ASSERT_GE(hnsw.cal_size() - size_before, int64_t(2 * nb * sizeof(hnswlib::vl_type)));
+}
+
 /*
 TEST_P(HNSWTest, HNSW_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
@@ -12,6 +12,7 @@
 #include <map>
 #include <exception>
 #include <google/protobuf/text_format.h>
+#include <google/protobuf/io/coded_stream.h>
 
 #include "pb/index_cgo_msg.pb.h"
 #include "knowhere/index/vector_index/VecIndexFactory.h"
@@ -228,62 +229,172 @@ IndexWrapper::StoreRawData(const knowhere::DatasetPtr& dataset) {
     }
 }
 
-/*
- * brief Return serialized binary set
- * TODO: use a more efficient method to manage memory, consider std::vector later
- */
-std::unique_ptr<IndexWrapper::Binary>
-IndexWrapper::Serialize() {
+knowhere::BinarySet
+IndexWrapper::GetBinarySet() {
     auto binarySet = index_->Serialize(config_);
     auto index_type = get_index_type();
     if (is_in_nm_list(index_type)) {
-        std::shared_ptr<uint8_t[]> raw_data(new uint8_t[raw_data_.size()], std::default_delete<uint8_t[]>());
-        memcpy(raw_data.get(), raw_data_.data(), raw_data_.size());
+        // raw data outlives the binary set, no need to copy it
+        std::shared_ptr<uint8_t[]> raw_data(raw_data_.data(), [](uint8_t*) {});
         binarySet.Append(RAW_DATA, raw_data, raw_data_.size());
         auto slice_size = get_index_file_slice_size();
         // https://github.com/milvus-io/milvus/issues/6421
         // Disassemble will only divide the raw vectors, other keys was already divided
         knowhere::Disassemble(slice_size * 1024 * 1024, binarySet);
     }
+    return binarySet;
+}
 
-    namespace indexcgo = milvus::proto::indexcgo;
-    indexcgo::BinarySet ret;
+namespace {
+class VectorSink : public IndexWrapper::BinarySink {
+ public:
+    explicit VectorSink(std::vector<char>& data) : data_(data) {
+    }
 
-    for (auto [key, value] : binarySet.binary_map_) {
-        auto binary = ret.add_datas();
-        binary->set_key(key);
-        binary->set_value(value->data.get(), value->size);
+    void
+    Reserve(size_t total_size) override {
+        data_.resize(total_size);
+        pos_ = 0;
     }
 
-    std::string serialized_data;
-    auto ok = ret.SerializeToString(&serialized_data);
-    Assert(ok);
+    void
+    Write(const void* data, size_t size) override {
+        Assert(pos_ + size <= data_.size());
+        memcpy(data_.data() + pos_, data, size);
+        pos_ += size;
+    }
 
-    auto binary = std::make_unique<IndexWrapper::Binary>();
-    binary->data.resize(serialized_data.length());
-    memcpy(binary->data.data(), serialized_data.c_str(), serialized_data.length());
+ private:
+    std::vector<char>& data_;
+    size_t pos_ = 0;
+};
 
-    return binary;
+// encoded as indexcgo::BinarySet, i.e. repeated Binary { string key = 1; bytes value = 2; } datas = 1
+constexpr uint8_t kLengthDelimitedTag1 = (1 << 3) | 2;
+constexpr uint8_t kLengthDelimitedTag2 = (2 << 3) | 2;
+
+size_t
+FieldSize(size_t length) {
+    // proto3 skips empty fields
+    return length ? 1 + google::protobuf::io::CodedOutputStream::VarintSize64(length) + length : 0;
+}
+
+size_t
+BinaryMessageSize(const std::string& key, const knowhere::BinaryPtr& value) {
+    return FieldSize(key.size()) + FieldSize(value->size);
 }
 
+uint64_t
+ReadVarint(const uint8_t*& ptr, const uint8_t* end) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        AssertInfo(ptr < end, "truncated index binary");
+        auto byte = *ptr++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    PanicInfo("malformed varint in index binary");
+}
+
+// calls fn(field, data, length) for each length delimited field of a message, others are skipped
+template <typename Fn>
 void
-IndexWrapper::Load(const char* serialized_sliced_blob_buffer, int32_t size) {
-    namespace indexcgo = milvus::proto::indexcgo;
-    auto data = std::string(serialized_sliced_blob_buffer, size);
-    indexcgo::BinarySet blob_buffer;
+ForEachField(const uint8_t* ptr, const uint8_t* end, Fn&& fn) {
+    while (ptr < end) {
+        auto tag = ReadVarint(ptr, end);
+        switch (tag & 7) {
+            case 0:
+                ReadVarint(ptr, end);
+                break;
+            case 1:
+                ptr += 8;
+                break;
+            case 5:
+                ptr += 4;
+                break;
+            case 2: {
+                auto length = ReadVarint(ptr, end);
+                AssertInfo(length <= uint64_t(end - ptr), "truncated index binary");
+                fn(uint32_t(tag >> 3), ptr, int64_t(length));
+                ptr += length;
+                break;
+            }
+            default:
+                PanicInfo("unsupported wire type in index binary");
+        }
+    }
+    AssertInfo(ptr == end, "truncated index binary");
+}
+}  // namespace
 
-    auto ok = blob_buffer.ParseFromString(data);
-    Assert(ok);
+/*
+ * brief Return serialized binary set
+ */
+std::unique_ptr<IndexWrapper::Binary>
+IndexWrapper::Serialize() {
+    auto binary = std::make_unique<IndexWrapper::Binary>();
+    VectorSink sink(binary->data);
+    Serialize(sink);
+    return binary;
+}
+
+void
+IndexWrapper::Serialize(BinarySink& sink) {
+    using google::protobuf::io::CodedOutputStream;
+    auto binarySet = GetBinarySet();
+
+    size_t total_size = 0;
+    for (auto& [key, value] : binarySet.binary_map_) {
+        auto message_size = BinaryMessageSize(key, value);
+        total_size += 1 + CodedOutputStream::VarintSize64(message_size) + message_size;
+    }
+    sink.Reserve(total_size);
+
+    // tag and length of each field, followed by its bytes
+    uint8_t header[1 + 10];
+    auto write_header = [&](uint8_t tag, size_t length) {
+        header[0] = tag;
+        auto end = CodedOutputStream::WriteVarint64ToArray(length, header + 1);
+        sink.Write(header, end - header);
+    };
+    for (auto& [key, value] : binarySet.binary_map_) {
+        write_header(kLengthDelimitedTag1, BinaryMessageSize(key, value));
+        if (!key.empty()) {
+            write_header(kLengthDelimitedTag1, key.size());
+            sink.Write(key.data(), key.size());
+        }
+        if (value->size) {
+            write_header(kLengthDelimitedTag2, value->size);
+            sink.Write(value->data.get(), value->size);
+        }
+    }
+}
 
+void
+IndexWrapper::Load(const char* serialized_sliced_blob_buffer, int32_t size) {
+    // the index may keep values after the load, so they are views of one owned copy of the buffer
+    std::shared_ptr<uint8_t[]> buffer(new uint8_t[size]);
+    memcpy(buffer.get(), serialized_sliced_blob_buffer, size);
     milvus::knowhere::BinarySet binarySet;
-    for (auto i = 0; i < blob_buffer.datas_size(); i++) {
-        const auto& binary = blob_buffer.datas(i);
-        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+    auto begin = buffer.get();
+    ForEachField(begin, begin + size, [&](uint32_t field, const uint8_t* data, int64_t length) {
+        if (field != 1) {
+            return;
+        }
+        std::string key;
         auto bptr = std::make_shared<milvus::knowhere::Binary>();
-        bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)binary.value().c_str(), deleter);
-        bptr->size = binary.value().length();
-        binarySet.Append(binary.key(), bptr);
-    }
+        ForEachField(data, data + length, [&](uint32_t field, const uint8_t* data, int64_t length) {
+            if (field == 1) {
+                key.assign(reinterpret_cast<const char*>(data), length);
+            } else if (field == 2) {
+                bptr->data = std::shared_ptr<uint8_t[]>(buffer, const_cast<uint8_t*>(data));
+                bptr->size = length;
+            }
+        });
+        binarySet.Append(key, bptr);
+    });
 
     index_->Load(binarySet);
 }
@@ -33,9 +33,27 @@ class IndexWrapper {
         std::vector<char> data;
     };
 
+    // receives the serialized index section by section, sections are never buffered in between
+    class BinarySink {
+     public:
+        virtual ~BinarySink() = default;
+
+        // called once with the total size before any write
+        virtual void
+        Reserve(size_t total_size) {
+        }
+
+        virtual void
+        Write(const void* data, size_t size) = 0;
+    };
+
     std::unique_ptr<Binary>
     Serialize();
 
+    // same format as Serialize(), written directly into sink
+    void
+    Serialize(BinarySink& sink);
+
     void
     Load(const char* serialized_sliced_blob_buffer, int32_t size);
 
@@ -72,6 +90,9 @@ class IndexWrapper {
     std::optional<T>
     get_config_by_name(std::string name);
 
+    knowhere::BinarySet
+    GetBinarySet();
+
     void
     StoreRawData(const knowhere::DatasetPtr& dataset);
 
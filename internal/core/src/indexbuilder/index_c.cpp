@@ -10,9 +10,12 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <string>
+#include <unistd.h>
+#include <cerrno>
 #include "index/knowhere/knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "indexbuilder/IndexWrapper.h"
 #include "indexbuilder/index_c.h"
+#include "exceptions/EasyAssert.h"
 
 class CGODebugUtils {
  public:
@@ -26,6 +29,29 @@ class CGODebugUtils {
     }
 };
 
+class FileSink : public milvus::indexbuilder::IndexWrapper::BinarySink {
+ public:
+    explicit FileSink(int fd) : fd_(fd) {
+    }
+
+    void
+    Write(const void* data, size_t size) override {
+        auto ptr = static_cast<const char*>(data);
+        while (size > 0) {
+            auto n = write(fd_, ptr, size);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            AssertInfo(n > 0, "failed to write index file");
+            ptr += n;
+            size -= n;
+        }
+    }
+
+ private:
+    int fd_;
+};
+
 CStatus
 CreateIndex(const char* serialized_type_params, const char* serialized_index_params, CIndex* res_index) {
     auto status = CStatus();
@@ -102,6 +128,22 @@ SerializeToSlicedBuffer(CIndex index, CBinary* c_binary) {
     return status;
 }
 
+CStatus
+SerializeToFile(CIndex index, int fd) {
+    auto status = CStatus();
+    try {
+        auto cIndex = (milvus::indexbuilder::IndexWrapper*)index;
+        FileSink sink(fd);
+        cIndex->Serialize(sink);
+        status.error_code = Success;
+        status.error_msg = "";
+    } catch (std::exception& e) {
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+    }
+    return status;
+}
+
 int64_t
 GetCBinarySize(CBinary c_binary) {
     auto cBinary = (milvus::indexbuilder::IndexWrapper::Binary*)c_binary;
@@ -52,6 +52,10 @@ BuildBinaryVecIndexWithoutIds(CIndex index, int64_t data_size, const uint8_t* ve
 CStatus
 SerializeToSlicedBuffer(CIndex index, CBinary* c_binary);
 
+// write the same bytes as SerializeToSlicedBuffer into fd, without buffering the whole index
+CStatus
+SerializeToFile(CIndex index, int fd);
+
 int64_t
 GetCBinarySize(CBinary c_binary);
 
@@ -0,0 +1,204 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <boost/dynamic_bitset.hpp>
+#include "boost_ext/dynamic_bitset_ext.hpp"
+
+// Columnar kernels evaluating predicates over a whole chunk, 64 rows per output word.
+// Bit (i % 64) of words[i / 64] stands for row i, the same layout as boost::dynamic_bitset blocks.
+// The per-row predicate is written into a byte array first, which the compiler vectorizes,
+// and then packed into the word without any branch.
+namespace milvus::query {
+
+constexpr int64_t BITS_PER_WORD = 64;
+
+inline uint64_t*
+get_words(boost::dynamic_bitset<>& bitset) {
+    static_assert(sizeof(boost::dynamic_bitset<>::block_type) == sizeof(uint64_t));
+    if (bitset.empty()) {
+        return nullptr;
+    }
+    return reinterpret_cast<uint64_t*>(boost_ext::get_data(bitset));
+}
+
+inline const uint64_t*
+get_words(const boost::dynamic_bitset<>& bitset) {
+    static_assert(sizeof(boost::dynamic_bitset<>::block_type) == sizeof(uint64_t));
+    if (bitset.empty()) {
+        return nullptr;
+    }
+    return reinterpret_cast<const uint64_t*>(boost_ext::get_data(bitset));
+}
+
+// pack 64 flags, each of which is 0 or 1, into a word
+inline uint64_t
+PackFlags(const uint8_t* flags) {
+    uint64_t word = 0;
+    for (int i = 0; i < 8; ++i) {
+        uint64_t bytes;
+        memcpy(&bytes, flags + i * 8, sizeof(bytes));
+        // gather the lowest bit of each byte into the highest byte
+        word |= ((bytes * 0x0102040810204080ULL) >> 56) << (i * 8);
+    }
+    return word;
+}
+
+// set bit i of words as func(i) for i in [0, size), bits in the tail of the last word are cleared.
+// if mask is given, words without any bit set in mask are cleared instead of evaluated
+template <typename Func>
+inline void
+FillWords(int64_t size, Func func, uint64_t* __restrict__ words, const uint64_t* __restrict__ mask = nullptr) {
+    uint8_t flags[BITS_PER_WORD];
+    auto num_full_words = size / BITS_PER_WORD;
+    for (int64_t word_id = 0; word_id < num_full_words; ++word_id) {
+        if (mask != nullptr && mask[word_id] == 0) {
+            words[word_id] = 0;
+            continue;
+        }
+        auto base = word_id * BITS_PER_WORD;
+        for (int64_t i = 0; i < BITS_PER_WORD; ++i) {
+            flags[i] = func(base + i);
+        }
+        words[word_id] = PackFlags(flags);
+    }
+    auto base = num_full_words * BITS_PER_WORD;
+    auto remain = size - base;
+    if (remain > 0) {
+        if (mask != nullptr && mask[num_full_words] == 0) {
+            words[num_full_words] = 0;
+            return;
+        }
+        memset(flags, 0, sizeof(flags));
+        for (int64_t i = 0; i < remain; ++i) {
+            flags[i] = func(base + i);
+        }
+        words[num_full_words] = PackFlags(flags);
+    }
+}
+
+// words <- { pred(src[i]) }
+template <typename T, typename Pred>
+inline void
+UnaryPredicateKernel(const T* __restrict__ src,
+                     int64_t size,
+                     Pred pred,
+                     uint64_t* __restrict__ words,
+                     const uint64_t* __restrict__ mask = nullptr) {
+    FillWords(size, [src, pred](int64_t i) -> bool { return pred(src[i]); }, words, mask);
+}
+
+// words <- { pred(left[i], right[i]) }
+template <typename L, typename R, typename Pred>
+inline void
+BinaryPredicateKernel(const L* __restrict__ left,
+                      const R* __restrict__ right,
+                      int64_t size,
+                      Pred pred,
+                      uint64_t* __restrict__ words,
+                      const uint64_t* __restrict__ mask = nullptr) {
+    FillWords(size, [left, right, pred](int64_t i) -> bool { return pred(left[i], right[i]); }, words, mask);
+}
+
+// dst[0, upper_div(size, 64)) <- bits [0, size) of src, bits in the tail of the last word are cleared
+inline void
+StoreBits(uint64_t* __restrict__ dst, const uint64_t* __restrict__ src, int64_t size) {
+    auto num_full_words = size / BITS_PER_WORD;
+    memcpy(dst, src, num_full_words * sizeof(uint64_t));
+    auto remain = size % BITS_PER_WORD;
+    if (remain > 0) {
+        dst[num_full_words] = src[num_full_words] & ((uint64_t(1) << remain) - 1);
+    }
+}
+
+// or bits [0, size) of src into dst starting at bit dst_offset, a word at a time
+// the target bits of dst are expected to be cleared, and so are the tail bits of src
+inline void
+CopyBits(uint64_t* __restrict__ dst, int64_t dst_offset, const uint64_t* __restrict__ src, int64_t size) {
+    auto dst_end_word = (dst_offset + size + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    auto num_src_words = (size + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    dst += dst_offset / BITS_PER_WORD;
+    dst_end_word -= dst_offset / BITS_PER_WORD;
+    auto shift = dst_offset % BITS_PER_WORD;
+    if (shift == 0) {
+        for (int64_t i = 0; i < num_src_words; ++i) {
+            dst[i] |= src[i];
+        }
+        return;
+    }
+    for (int64_t i = 0; i < num_src_words; ++i) {
+        dst[i] |= src[i] << shift;
+        if (i + 1 < dst_end_word) {
+            dst[i + 1] |= src[i] >> (BITS_PER_WORD - shift);
+        }
+    }
+}
+
+// whether any bit in [begin, end) of words is set
+inline bool
+HasSetBit(const uint64_t* words, int64_t begin, int64_t end) {
+    if (begin >= end) {
+        return false;
+    }
+    auto first = begin / BITS_PER_WORD;
+    auto last = (end - 1) / BITS_PER_WORD;
+    auto head = ~uint64_t(0) << (begin % BITS_PER_WORD);
+    auto tail = ~uint64_t(0) >> (BITS_PER_WORD - 1 - (end - 1) % BITS_PER_WORD);
+    if (first == last) {
+        return (words[first] & head & tail) != 0;
+    }
+    if ((words[first] & head) != 0 || (words[last] & tail) != 0) {
+        return true;
+    }
+    for (auto word_id = first + 1; word_id < last; ++word_id) {
+        if (words[word_id] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// number of words in [0, upper_div(size, 64)) with any bit set
+inline int64_t
+CountNonZeroWords(const uint64_t* words, int64_t size) {
+    auto num_words = (size + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    int64_t count = 0;
+    for (int64_t word_id = 0; word_id < num_words; ++word_id) {
+        count += words[word_id] != 0;
+    }
+    return count;
+}
+
+// call func(i) on each set bit i in [0, size) in ascending order, a word at a time
+// stops as soon as func returns false
+template <typename Func>
+inline void
+ForEachSetBit(const uint64_t* __restrict__ words, int64_t size, Func func) {
+    auto num_words = (size + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    for (int64_t word_id = 0; word_id < num_words; ++word_id) {
+        auto word = words[word_id];
+        if (word_id == num_words - 1 && size % BITS_PER_WORD != 0) {
+            word &= (uint64_t(1) << (size % BITS_PER_WORD)) - 1;
+        }
+        auto base = word_id * BITS_PER_WORD;
+        while (word) {
+            if (!func(base + __builtin_ctzll(word))) {
+                return;
+            }
+            word &= word - 1;
+        }
+    }
+}
+
+}  // namespace milvus::query
@@ -15,6 +15,7 @@
 #include <any>
 #include <string>
 #include <optional>
+#include <limits>
 #include "Expr.h"
 #include "utils/Json.h"
 namespace milvus::query {
@@ -61,6 +62,10 @@ struct RetrievePlanNode : PlanNode {
     accept(PlanNodeVisitor&) override;
 
     ExprPtr predicate_;
+    // window of matched rows to return. a segment only knows its own matches, so it returns the first
+    // offset_ + limit_ of them and offset_ is skipped by the caller once the segments' results are merged
+    int64_t offset_ = 0;
+    int64_t limit_ = std::numeric_limits<int64_t>::max();
 };
 
 }  // namespace milvus::query
@@ -19,7 +19,80 @@
 #include "query/SearchBruteForce.h"
 #include "query/SearchOnIndex.h"
 
+#include <omp.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_arena.h>
+
 namespace milvus::query {
+
+// max number of chunks searched concurrently for one request, 0 means no limit
+static int64_t
+GetSegmentParallelism(const query::SearchInfo& info) {
+    constexpr auto key = "segment_parallelism";
+    auto& params = info.search_params_;
+    if (!params.is_object() || !params.contains(key)) {
+        return 0;
+    }
+    auto parallelism = params[key].get<int64_t>();
+    AssertInfo(parallelism >= 0, "segment_parallelism should be non-negative");
+    return parallelism;
+}
+
+// chunks already run concurrently, so keep the knowhere/faiss omp loops inside each chunk serial
+class OmpSerialGuard {
+ public:
+    OmpSerialGuard() : saved_(omp_get_max_threads()) {
+        omp_set_num_threads(1);
+    }
+    ~OmpSerialGuard() {
+        omp_set_num_threads(saved_);
+    }
+
+ private:
+    int saved_;
+};
+
+// search chunks [chunk_begin, chunk_end) and merge the results in chunk order,
+// concurrently chunks are reduced as a tree, which gives the same result as merging them one by one
+template <typename ChunkSearch>
+static SubSearchResult
+SearchChunks(const query::SearchInfo& info,
+             int64_t num_queries,
+             int64_t chunk_begin,
+             int64_t chunk_end,
+             ChunkSearch search_chunk) {
+    SubSearchResult identity(num_queries, info.topk_, info.metric_type_);
+    auto parallelism = GetSegmentParallelism(info);
+    if (parallelism == 1 || chunk_end - chunk_begin <= 1) {
+        for (auto chunk_id = chunk_begin; chunk_id < chunk_end; ++chunk_id) {
+            identity.merge(search_chunk(chunk_id));
+        }
+        return identity;
+    }
+
+    auto reduce = [&] {
+        return tbb::parallel_reduce(
+            tbb::blocked_range<int64_t>(chunk_begin, chunk_end, 1), identity,
+            [&](const tbb::blocked_range<int64_t>& range, SubSearchResult acc) {
+                OmpSerialGuard guard;
+                for (auto chunk_id = range.begin(); chunk_id != range.end(); ++chunk_id) {
+                    acc.merge(search_chunk(chunk_id));
+                }
+                return acc;
+            },
+            [](SubSearchResult left, const SubSearchResult& right) {
+                left.merge(right);
+                return left;
+            });
+    };
+    if (parallelism == 0) {
+        return reduce();
+    }
+    tbb::task_arena arena(parallelism);
+    return arena.execute(reduce);
+}
+
 Status
 FloatSearch(const segcore::SegmentGrowingImpl& segment,
             const query::SearchInfo& info,
@@ -54,60 +127,50 @@ FloatSearch(const segcore::SegmentGrowingImpl& segment,
     // step 3: small indexing search
     // std::vector<int64_t> final_uids(total_count, -1);
     // std::vector<float> final_dis(total_count, std::numeric_limits<float>::max());
-    SubSearchResult final_qr(num_queries, topk, metric_type);
     dataset::SearchDataset search_dataset{metric_type, num_queries, topk, dim, query_data};
     auto vec_ptr = record.get_field_data<FloatVector>(vecfield_offset);
 
-    int current_chunk_id = 0;
-
-    if (indexing_record.is_in(vecfield_offset)) {
-        auto max_indexed_id = indexing_record.get_finished_ack();
-        const auto& field_indexing = indexing_record.get_vec_field_indexing(vecfield_offset);
-        auto search_conf = field_indexing.get_search_params(topk);
-        Assert(vec_ptr->get_size_per_chunk() == field_indexing.get_size_per_chunk());
-
-        for (int chunk_id = current_chunk_id; chunk_id < max_indexed_id; ++chunk_id) {
-            auto size_per_chunk = field_indexing.get_size_per_chunk();
-            auto indexing = field_indexing.get_chunk_indexing(chunk_id);
-
-            auto sub_view = BitsetSubView(bitset, chunk_id * size_per_chunk, size_per_chunk);
-            auto sub_qr = SearchOnIndex(search_dataset, *indexing, search_conf, sub_view);
-
-            // convert chunk uid to segment uid
-            for (auto& x : sub_qr.mutable_labels()) {
-                if (x != -1) {
-                    x += chunk_id * size_per_chunk;
-                }
-            }
-
-            final_qr.merge(sub_qr);
-        }
-        current_chunk_id = max_indexed_id;
-    }
-
-    // step 4: brute force search where small indexing is unavailable
     auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
     auto max_chunk = upper_div(ins_barrier, vec_size_per_chunk);
+    int64_t max_indexed_id = 0;
+    const segcore::VectorFieldIndexing* field_indexing = nullptr;
+    knowhere::Config search_conf;
 
-    for (int chunk_id = current_chunk_id; chunk_id < max_chunk; ++chunk_id) {
-        auto& chunk = vec_ptr->get_chunk(chunk_id);
+    if (indexing_record.is_in(vecfield_offset)) {
+        max_indexed_id = indexing_record.get_finished_ack();
+        field_indexing = &indexing_record.get_vec_field_indexing(vecfield_offset);
+        search_conf = field_indexing->get_search_params(topk);
+        Assert(vec_size_per_chunk == field_indexing->get_size_per_chunk());
+    }
 
+    auto search_chunk = [&](int64_t chunk_id) {
         auto element_begin = chunk_id * vec_size_per_chunk;
         auto element_end = std::min(ins_barrier, (chunk_id + 1) * vec_size_per_chunk);
         auto size_per_chunk = element_end - element_begin;
-
         auto sub_view = BitsetSubView(bitset, element_begin, size_per_chunk);
-        auto sub_qr = FloatSearchBruteForce(search_dataset, chunk.data(), size_per_chunk, sub_view);
+
+        // step 3: small indexing search, only on chunks visible as a whole
+        // step 4: brute force search where small indexing is unavailable
+        auto sub_qr = [&] {
+            auto indexing = chunk_id < max_indexed_id && size_per_chunk == vec_size_per_chunk
+                                ? field_indexing->get_chunk_indexing(chunk_id)
+                                : nullptr;
+            if (indexing != nullptr) {
+                return SearchOnIndex(search_dataset, *indexing, search_conf, sub_view);
+            }
+            auto& chunk = vec_ptr->get_chunk(chunk_id);
+            return FloatSearchBruteForce(search_dataset, chunk.data(), size_per_chunk, sub_view);
+        }();
 
         // convert chunk uid to segment uid
         for (auto& x : sub_qr.mutable_labels()) {
             if (x != -1) {
-                x += chunk_id * vec_size_per_chunk;
+                x += element_begin;
             }
         }
-        final_qr.merge(sub_qr);
-    }
-    current_chunk_id = max_chunk;
+        return sub_qr;
+    };
+    auto final_qr = SearchChunks(info, num_queries, 0, max_chunk, search_chunk);
 
     results.result_distances_ = std::move(final_qr.mutable_values());
     results.internal_seg_offsets_ = std::move(final_qr.mutable_labels());
@@ -154,13 +217,10 @@ BinarySearch(const segcore::SegmentGrowingImpl& segment,
 
     auto vec_ptr = record.get_field_data<BinaryVector>(vecfield_offset);
 
-    auto max_indexed_id = 0;
     // step 4: brute force search where small indexing is unavailable
-
     auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
     auto max_chunk = upper_div(ins_barrier, vec_size_per_chunk);
-    SubSearchResult final_result(num_queries, topk, metric_type);
-    for (int chunk_id = max_indexed_id; chunk_id < max_chunk; ++chunk_id) {
+    auto search_chunk = [&](int64_t chunk_id) {
         auto& chunk = vec_ptr->get_chunk(chunk_id);
         auto element_begin = chunk_id * vec_size_per_chunk;
         auto element_end = std::min(ins_barrier, (chunk_id + 1) * vec_size_per_chunk);
@@ -172,11 +232,12 @@ BinarySearch(const segcore::SegmentGrowingImpl& segment,
         // convert chunk uid to segment uid
         for (auto& x : sub_result.mutable_labels()) {
             if (x != -1) {
-                x += chunk_id * vec_size_per_chunk;
+                x += element_begin;
             }
         }
-        final_result.merge(sub_result);
-    }
+        return sub_result;
+    };
+    auto final_result = SearchChunks(info, num_queries, 0, max_chunk, search_chunk);
 
     results.result_distances_ = std::move(final_result.mutable_values());
     results.internal_seg_offsets_ = std::move(final_result.mutable_labels());
@@ -17,9 +17,6 @@
 #include "query/SubSearchResult.h"
 
 namespace milvus::query {
-using BitsetChunk = boost::dynamic_bitset<>;
-using BitsetSimple = std::deque<BitsetChunk>;
-
 void
 SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
                 int64_t ins_barrier,
@@ -23,37 +23,12 @@ SubSearchResult::merge_impl(const SubSearchResult& right) {
     Assert(metric_type_ == right.metric_type_);
     Assert(is_desc == is_descending(metric_type_));
 
+    // entries of this go first on ties
+    auto before = [](float right_v, float left_v) { return is_desc ? right_v > left_v : right_v < left_v; };
     for (int64_t qn = 0; qn < num_queries_; ++qn) {
         auto offset = qn * topk_;
-
-        int64_t* __restrict__ left_labels = this->get_labels() + offset;
-        float* __restrict__ left_values = this->get_values() + offset;
-
-        auto right_labels = right.get_labels() + offset;
-        auto right_values = right.get_values() + offset;
-
-        std::vector<float> buf_values(topk_);
-        std::vector<int64_t> buf_labels(topk_);
-
-        auto lit = 0;  // left iter
-        auto rit = 0;  // right iter
-
-        for (auto buf_iter = 0; buf_iter < topk_; ++buf_iter) {
-            auto left_v = left_values[lit];
-            auto right_v = right_values[rit];
-            // optimize out at compiling
-            if (is_desc ? (left_v >= right_v) : (left_v <= right_v)) {
-                buf_values[buf_iter] = left_values[lit];
-                buf_labels[buf_iter] = left_labels[lit];
-                ++lit;
-            } else {
-                buf_values[buf_iter] = right_values[rit];
-                buf_labels[buf_iter] = right_labels[rit];
-                ++rit;
-            }
-        }
-        std::copy_n(buf_values.data(), topk_, left_values);
-        std::copy_n(buf_labels.data(), topk_, left_labels);
+        segcore::merge_topk_inplace(topk_, this->get_values() + offset, this->get_labels() + offset,
+                                    right.get_values() + offset, right.get_labels() + offset, before);
     }
 }
 
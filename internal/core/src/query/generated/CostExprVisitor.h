@@ -0,0 +1,67 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+// Generated File
+// DO NOT EDIT
+#include <cmath>
+#include <optional>
+#include "segcore/SegmentInterface.h"
+#include "ExprVisitor.h"
+
+namespace milvus::query {
+class CostExprVisitor : public ExprVisitor {
+ public:
+    void
+    visit(LogicalUnaryExpr& expr) override;
+
+    void
+    visit(LogicalBinaryExpr& expr) override;
+
+    void
+    visit(TermExpr& expr) override;
+
+    void
+    visit(UnaryRangeExpr& expr) override;
+
+    void
+    visit(BinaryRangeExpr& expr) override;
+
+    void
+    visit(CompareExpr& expr) override;
+
+ public:
+    // the fraction of rows expected to pass, and the cost of evaluating a row relative to a scan
+    struct RetType {
+        double selectivity;
+        double cost;
+    };
+    explicit CostExprVisitor(const segcore::SegmentInternalInterface& segment) : segment_(segment) {
+    }
+    RetType
+    call_child(Expr& expr) {
+        Assert(!ret_.has_value());
+        expr.accept(*this);
+        Assert(ret_.has_value());
+        auto res = ret_.value();
+        ret_ = std::nullopt;
+        return res;
+    }
+
+ private:
+    double
+    ScanCost(FieldOffset field_offset) const;
+
+ private:
+    const segcore::SegmentInternalInterface& segment_;
+    std::optional<RetType> ret_;
+};
+}  // namespace milvus::query
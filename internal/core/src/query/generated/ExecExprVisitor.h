@@ -12,13 +12,15 @@
 #pragma once
 // Generated File
 // DO NOT EDIT
+#include <algorithm>
 #include <optional>
+#include <vector>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/variant.hpp>
 #include <utility>
-#include <deque>
 #include "segcore/SegmentGrowingImpl.h"
 #include "query/ExprImpl.h"
+#include "query/ExprKernel.h"
 #include "ExprVisitor.h"
 
 namespace milvus::query {
@@ -57,6 +59,16 @@ class ExecExprVisitor : public ExprVisitor {
         return std::move(res.value());
     }
 
+    // evaluate expr only on the rows set in mask, the other rows are left unset
+    RetType
+    call_child(Expr& expr, const RetType* mask) {
+        auto outer_mask = mask_;
+        mask_ = mask;
+        auto res = call_child(expr);
+        mask_ = outer_mask;
+        return res;
+    }
+
  public:
     template <typename T, typename IndexFunc, typename ElementFunc>
     auto
@@ -74,14 +86,27 @@ class ExecExprVisitor : public ExprVisitor {
     auto
     ExecTermVisitorImpl(TermExpr& expr_raw) -> RetType;
 
+    template <typename L, typename R, typename CmpFunc>
+    auto
+    ExecCompareVisitorImpl(CompareExpr& expr, CmpFunc cmp_func) -> RetType;
+
+    template <typename L, typename CmpFunc>
+    auto
+    ExecCompareRightDispatcher(CompareExpr& expr, CmpFunc cmp_func) -> RetType;
+
     template <typename CmpFunc>
     auto
     ExecCompareExprDispatcher(CompareExpr& expr, CmpFunc cmp_func) -> RetType;
 
+    auto
+    ExecLogicalChain(LogicalBinaryExpr& expr) -> RetType;
+
  private:
     const segcore::SegmentInternalInterface& segment_;
     int64_t row_count_;
     std::optional<RetType> ret_;
     Timestamp timestamp_;
+    // rows the visited expression is evaluated on, nullptr for all rows
+    const RetType* mask_ = nullptr;
 };
 }  // namespace milvus::query
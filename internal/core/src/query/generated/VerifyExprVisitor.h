@@ -12,13 +12,15 @@
 #pragma once
 // Generated File
 // DO NOT EDIT
+#include <algorithm>
 #include <optional>
+#include <vector>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/variant.hpp>
 #include <utility>
-#include <deque>
 #include "segcore/SegmentGrowingImpl.h"
 #include "query/ExprImpl.h"
+#include "query/ExprKernel.h"
 #include "ExprVisitor.h"
 
 namespace milvus::query {
@@ -0,0 +1,175 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <cmath>
+#include <optional>
+#include "segcore/SegmentInterface.h"
+#include "query/generated/CostExprVisitor.h"
+#include "query/ExprImpl.h"
+
+namespace milvus::query {
+#if 1
+// THIS CONTAINS EXTRA BODY FOR VISITOR
+// WILL BE USED BY GENERATOR
+namespace impl {
+class CostExprVisitor : ExprVisitor {
+ public:
+    // the fraction of rows expected to pass, and the cost of evaluating a row relative to a scan
+    struct RetType {
+        double selectivity;
+        double cost;
+    };
+    explicit CostExprVisitor(const segcore::SegmentInternalInterface& segment) : segment_(segment) {
+    }
+    RetType
+    call_child(Expr& expr) {
+        Assert(!ret_.has_value());
+        expr.accept(*this);
+        Assert(ret_.has_value());
+        auto res = ret_.value();
+        ret_ = std::nullopt;
+        return res;
+    }
+
+ private:
+    double
+    ScanCost(FieldOffset field_offset) const;
+
+ private:
+    const segcore::SegmentInternalInterface& segment_;
+    std::optional<RetType> ret_;
+};
+}  // namespace impl
+#endif
+
+// no statistics are kept, so the selectivities are the usual textbook guesses
+constexpr double kEqualSelectivity = 0.1;
+constexpr double kRangeSelectivity = 1.0 / 3;
+constexpr double kBetweenSelectivity = 0.25;
+// an index lookup is mostly a binary search and a copy of the resulting bitset
+constexpr double kIndexCost = 0.25;
+
+static double
+OpSelectivity(OpType op, DataType data_type) {
+    auto equal = data_type == DataType::BOOL ? 0.5 : kEqualSelectivity;
+    switch (op) {
+        case OpType::Equal:
+            return equal;
+        case OpType::NotEqual:
+            return 1 - equal;
+        default:
+            return kRangeSelectivity;
+    }
+}
+
+double
+CostExprVisitor::ScanCost(FieldOffset field_offset) const {
+    return segment_.num_chunk_index(field_offset) > 0 ? kIndexCost : 1;
+}
+
+void
+CostExprVisitor::visit(LogicalUnaryExpr& expr) {
+    auto child = call_child(*expr.child_);
+    ret_ = RetType{1 - child.selectivity, child.cost};
+}
+
+// the right side is only evaluated on the rows the left side leaves undecided
+void
+CostExprVisitor::visit(LogicalBinaryExpr& expr) {
+    using OpType = LogicalBinaryExpr::OpType;
+    auto left = call_child(*expr.left_);
+    auto right = call_child(*expr.right_);
+    auto l = left.selectivity;
+    auto r = right.selectivity;
+    switch (expr.op_type_) {
+        case OpType::LogicalAnd: {
+            ret_ = RetType{l * r, left.cost + l * right.cost};
+            break;
+        }
+        case OpType::LogicalOr: {
+            ret_ = RetType{l + r - l * r, left.cost + (1 - l) * right.cost};
+            break;
+        }
+        case OpType::LogicalXor: {
+            ret_ = RetType{l + r - 2 * l * r, left.cost + right.cost};
+            break;
+        }
+        case OpType::LogicalMinus: {
+            ret_ = RetType{l * (1 - r), left.cost + l * right.cost};
+            break;
+        }
+        default: {
+            PanicInfo("Invalid Binary Op");
+        }
+    }
+}
+
+template <typename T>
+static int64_t
+TermCount(TermExpr& expr) {
+    return static_cast<TermExprImpl<T>&>(expr).terms_.size();
+}
+
+// terms are looked up by binary search on every row
+void
+CostExprVisitor::visit(TermExpr& expr) {
+    int64_t count = 0;
+    switch (expr.data_type_) {
+        case DataType::BOOL: {
+            count = TermCount<bool>(expr);
+            break;
+        }
+        case DataType::INT8: {
+            count = TermCount<int8_t>(expr);
+            break;
+        }
+        case DataType::INT16: {
+            count = TermCount<int16_t>(expr);
+            break;
+        }
+        case DataType::INT32: {
+            count = TermCount<int32_t>(expr);
+            break;
+        }
+        case DataType::INT64: {
+            count = TermCount<int64_t>(expr);
+            break;
+        }
+        case DataType::FLOAT: {
+            count = TermCount<float>(expr);
+            break;
+        }
+        case DataType::DOUBLE: {
+            count = TermCount<double>(expr);
+            break;
+        }
+        default:
+            PanicInfo("unsupported");
+    }
+    ret_ = RetType{std::min(1.0, count * kEqualSelectivity), 1 + std::log2(count + 1.0)};
+}
+
+void
+CostExprVisitor::visit(UnaryRangeExpr& expr) {
+    ret_ = RetType{OpSelectivity(expr.op_type_, expr.data_type_), ScanCost(expr.field_offset_)};
+}
+
+void
+CostExprVisitor::visit(BinaryRangeExpr& expr) {
+    ret_ = RetType{kBetweenSelectivity, ScanCost(expr.field_offset_)};
+}
+
+void
+CostExprVisitor::visit(CompareExpr& expr) {
+    ret_ = RetType{OpSelectivity(expr.op_type_, expr.left_data_type_), 2};
+}
+
+}  // namespace milvus::query
@@ -9,14 +9,17 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
 #include <optional>
+#include <vector>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/variant.hpp>
 #include <utility>
-#include <deque>
 #include "segcore/SegmentGrowingImpl.h"
 #include "query/ExprImpl.h"
+#include "query/ExprKernel.h"
 #include "query/generated/ExecExprVisitor.h"
+#include "query/generated/CostExprVisitor.h"
 
 namespace milvus::query {
 #if 1
@@ -39,6 +42,16 @@ class ExecExprVisitor : ExprVisitor {
         return std::move(res.value());
     }
 
+    // evaluate expr only on the rows set in mask, the other rows are left unset
+    RetType
+    call_child(Expr& expr, const RetType* mask) {
+        auto outer_mask = mask_;
+        mask_ = mask;
+        auto res = call_child(expr);
+        mask_ = outer_mask;
+        return res;
+    }
+
  public:
     template <typename T, typename IndexFunc, typename ElementFunc>
     auto
@@ -56,27 +69,48 @@ class ExecExprVisitor : ExprVisitor {
     auto
     ExecTermVisitorImpl(TermExpr& expr_raw) -> RetType;
 
+    template <typename L, typename R, typename CmpFunc>
+    auto
+    ExecCompareVisitorImpl(CompareExpr& expr, CmpFunc cmp_func) -> RetType;
+
+    template <typename L, typename CmpFunc>
+    auto
+    ExecCompareRightDispatcher(CompareExpr& expr, CmpFunc cmp_func) -> RetType;
+
     template <typename CmpFunc>
     auto
     ExecCompareExprDispatcher(CompareExpr& expr, CmpFunc cmp_func) -> RetType;
 
+    auto
+    ExecLogicalChain(LogicalBinaryExpr& expr) -> RetType;
+
  private:
     const segcore::SegmentInternalInterface& segment_;
     int64_t row_count_;
     std::optional<RetType> ret_;
     Timestamp timestamp_;
+    // rows the visited expression is evaluated on, nullptr for all rows
+    const RetType* mask_ = nullptr;
 };
 }  // namespace impl
 #endif
 
+// a chunk with less than 1 / kIndexScanRatio of its words in the mask is scanned rather than looked up in the index
+constexpr int64_t kIndexScanRatio = 8;
+// keeps the rank of a term deciding almost no row finite
+constexpr double kMinDecidedRatio = 1e-3;
+
 void
 ExecExprVisitor::visit(LogicalUnaryExpr& expr) {
     using OpType = LogicalUnaryExpr::OpType;
-    auto child_res = call_child(*expr.child_);
+    auto child_res = call_child(*expr.child_, mask_);
     RetType res = std::move(child_res);
     switch (expr.op_type_) {
         case OpType::LogicalNot: {
             res.flip();
+            if (mask_ != nullptr) {
+                res &= *mask_;
+            }
             break;
         }
         default: {
@@ -87,28 +121,83 @@ ExecExprVisitor::visit(LogicalUnaryExpr& expr) {
     ret_ = std::move(res);
 }
 
+// flatten nested ands (ors) into their terms
+static void
+CollectLogicalChain(Expr& expr, LogicalBinaryExpr::OpType op, std::vector<Expr*>& terms) {
+    auto logical = dynamic_cast<LogicalBinaryExpr*>(&expr);
+    if (logical != nullptr && logical->op_type_ == op) {
+        CollectLogicalChain(*logical->left_, op, terms);
+        CollectLogicalChain(*logical->right_, op, terms);
+        return;
+    }
+    terms.push_back(&expr);
+}
+
+// the terms of an and (or) chain are evaluated one after another, each only on the rows still true (false),
+// starting from the terms which decide the most rows at the least cost
+auto
+ExecExprVisitor::ExecLogicalChain(LogicalBinaryExpr& expr) -> RetType {
+    using OpType = LogicalBinaryExpr::OpType;
+    auto op = expr.op_type_;
+    std::vector<Expr*> terms;
+    CollectLogicalChain(expr, op, terms);
+
+    CostExprVisitor cost_visitor(segment_);
+    std::vector<std::pair<double, Expr*>> ranked;
+    for (auto term : terms) {
+        auto estimate = cost_visitor.call_child(*term);
+        auto decided = op == OpType::LogicalAnd ? 1 - estimate.selectivity : estimate.selectivity;
+        ranked.emplace_back(estimate.cost / std::max(decided, kMinDecidedRatio), term);
+    }
+    std::stable_sort(
+        ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    auto res = call_child(*ranked[0].second, mask_);
+    for (size_t i = 1; i < ranked.size(); ++i) {
+        if (op == OpType::LogicalAnd) {
+            if (res.none()) {
+                break;
+            }
+            auto term_res = call_child(*ranked[i].second, &res);
+            res = std::move(term_res);
+        } else {
+            auto undecided = ~res;
+            if (mask_ != nullptr) {
+                undecided &= *mask_;
+            }
+            if (undecided.none()) {
+                break;
+            }
+            res |= call_child(*ranked[i].second, &undecided);
+        }
+    }
+    return res;
+}
+
 void
 ExecExprVisitor::visit(LogicalBinaryExpr& expr) {
     using OpType = LogicalBinaryExpr::OpType;
-    auto left = call_child(*expr.left_);
-    auto right = call_child(*expr.right_);
-    Assert(left.size() == right.size());
-    auto res = std::move(left);
+    RetType res;
     switch (expr.op_type_) {
-        case OpType::LogicalAnd: {
-            res &= right;
-            break;
-        }
+        case OpType::LogicalAnd:
         case OpType::LogicalOr: {
-            res |= right;
+            res = ExecLogicalChain(expr);
             break;
         }
         case OpType::LogicalXor: {
+            res = call_child(*expr.left_, mask_);
+            auto right = call_child(*expr.right_, mask_);
+            Assert(res.size() == right.size());
             res ^= right;
             break;
         }
         case OpType::LogicalMinus: {
-            res -= right;
+            res = call_child(*expr.left_, mask_);
+            if (res.any()) {
+                auto right = call_child(*expr.right_, &res);
+                Assert(res.size() == right.size());
+                res -= right;
+            }
             break;
         }
         default: {
@@ -119,22 +208,37 @@ ExecExprVisitor::visit(LogicalBinaryExpr& expr) {
     ret_ = std::move(res);
 }
 
+// evaluate a segment-wide bitset chunk by chunk, fill_chunk(chunk_id, size, words, mask_words) writes the bits of
+// one chunk into words. When a chunk starts at a word boundary, words points into the result directly,
+// otherwise it is a scratch buffer which is spliced into the result afterwards.
+// With a mask, chunks without any row in it are skipped, and an aligned chunk gets its part of the mask
+// in mask_words so that empty words are skipped too. Rows outside the mask are cleared in the end.
+template <typename FillChunk>
 static auto
-Assemble(const std::deque<boost::dynamic_bitset<>>& srcs) -> boost::dynamic_bitset<> {
-    boost::dynamic_bitset<> res;
-
-    int64_t total_size = 0;
-    for (auto& chunk : srcs) {
-        total_size += chunk.size();
-    }
-    res.resize(total_size);
-
-    int64_t counter = 0;
-    for (auto& chunk : srcs) {
-        for (int64_t i = 0; i < chunk.size(); ++i) {
-            res[counter + i] = chunk[i];
+ExecByChunk(int64_t row_count, int64_t size_per_chunk, const boost::dynamic_bitset<>* mask, FillChunk fill_chunk)
+    -> boost::dynamic_bitset<> {
+    boost::dynamic_bitset<> res(row_count);
+    auto res_words = get_words(res);
+    auto mask_words = mask == nullptr ? nullptr : get_words(*mask);
+    auto num_chunk = upper_div(row_count, size_per_chunk);
+    std::vector<uint64_t> scratch;
+    for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+        auto offset = chunk_id * size_per_chunk;
+        auto size = std::min(size_per_chunk, row_count - offset);
+        if (mask != nullptr && !HasSetBit(mask_words, offset, offset + size)) {
+            continue;
+        }
+        if (offset % BITS_PER_WORD == 0) {
+            auto chunk_mask = mask == nullptr ? nullptr : mask_words + offset / BITS_PER_WORD;
+            fill_chunk(chunk_id, size, res_words + offset / BITS_PER_WORD, chunk_mask);
+        } else {
+            scratch.resize(upper_div(size_per_chunk, BITS_PER_WORD));
+            fill_chunk(chunk_id, size, scratch.data(), nullptr);
+            CopyBits(res_words, offset, scratch.data(), size);
         }
-        counter += chunk.size();
+    }
+    if (mask != nullptr) {
+        res &= *mask;
     }
     return res;
 }
@@ -147,30 +251,28 @@ ExecExprVisitor::ExecRangeVisitorImpl(FieldOffset field_offset, IndexFunc index_
     auto& field_meta = schema[field_offset];
     auto indexing_barrier = segment_.num_chunk_index(field_offset);
     auto size_per_chunk = segment_.size_per_chunk();
-    auto num_chunk = upper_div(row_count_, size_per_chunk);
-    std::deque<boost::dynamic_bitset<>> results;
 
     using Index = knowhere::scalar::StructuredIndex<T>;
-    for (auto chunk_id = 0; chunk_id < indexing_barrier; ++chunk_id) {
-        const Index& indexing = segment_.chunk_scalar_index<T>(field_offset, chunk_id);
-        // NOTE: knowhere is not const-ready
-        // This is a dirty workaround
-        auto data = index_func(const_cast<Index*>(&indexing));
-        Assert(data->size() == size_per_chunk);
-        results.emplace_back(std::move(*data));
-    }
-    for (auto chunk_id = indexing_barrier; chunk_id < num_chunk; ++chunk_id) {
-        auto this_size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
-        boost::dynamic_bitset<> result(this_size);
+    auto fill_chunk = [&](int64_t chunk_id, int64_t size, uint64_t* words, const uint64_t* mask) {
+        // a chunk that is only partially visible is evaluated on the raw data, and so is a chunk with
+        // few rows left in the mask, since the index lookup produces the bits of the whole chunk anyway
+        auto num_words = upper_div(size, BITS_PER_WORD);
+        bool sparse = mask != nullptr && CountNonZeroWords(mask, size) * kIndexScanRatio < num_words;
+        if (chunk_id < indexing_barrier && size == size_per_chunk && !sparse &&
+            segment_.has_chunk_index(field_offset, chunk_id)) {
+            const Index& indexing = segment_.chunk_scalar_index<T>(field_offset, chunk_id);
+            // NOTE: knowhere is not const-ready
+            // This is a dirty workaround
+            auto data = index_func(const_cast<Index*>(&indexing));
+            Assert(data->size() == size_per_chunk);
+            StoreBits(words, get_words(*data), size);
+            return;
+        }
         auto chunk = segment_.chunk_data<T>(field_offset, chunk_id);
         const T* data = chunk.data();
-        for (int index = 0; index < this_size; ++index) {
-            result[index] = element_func(data[index]);
-        }
-        Assert(result.size() == this_size);
-        results.emplace_back(std::move(result));
-    }
-    auto final_result = Assemble(results);
+        UnaryPredicateKernel(data, size, element_func, words, mask);
+    };
+    auto final_result = ExecByChunk(row_count_, size_per_chunk, mask_, fill_chunk);
     Assert(final_result.size() == row_count_);
     return final_result;
 }
@@ -339,76 +441,79 @@ ExecExprVisitor::visit(BinaryRangeExpr& expr) {
     ret_ = std::move(res);
 }
 
-template <typename Op>
-struct relational {
-    template <typename T, typename U>
-    bool
-    operator()(T const& a, U const& b) const {
-        return Op{}(a, b);
-    }
-    template <typename... T>
-    bool
-    operator()(T const&...) const {
-        PanicInfo("incompatible operands");
+template <typename L, typename R, typename Op>
+auto
+ExecExprVisitor::ExecCompareVisitorImpl(CompareExpr& expr, Op op) -> RetType {
+    auto size_per_chunk = segment_.size_per_chunk();
+    auto fill_chunk = [&](int64_t chunk_id, int64_t size, uint64_t* words, const uint64_t* mask) {
+        auto left = segment_.chunk_data<L>(expr.left_field_offset_, chunk_id).data();
+        auto right = segment_.chunk_data<R>(expr.right_field_offset_, chunk_id).data();
+        BinaryPredicateKernel(left, right, size, op, words, mask);
+    };
+    auto final_result = ExecByChunk(row_count_, size_per_chunk, mask_, fill_chunk);
+    Assert(final_result.size() == row_count_);
+    return final_result;
+}
+
+template <typename L, typename Op>
+auto
+ExecExprVisitor::ExecCompareRightDispatcher(CompareExpr& expr, Op op) -> RetType {
+    switch (expr.right_data_type_) {
+        case DataType::BOOL: {
+            return ExecCompareVisitorImpl<L, bool>(expr, op);
+        }
+        case DataType::INT8: {
+            return ExecCompareVisitorImpl<L, int8_t>(expr, op);
+        }
+        case DataType::INT16: {
+            return ExecCompareVisitorImpl<L, int16_t>(expr, op);
+        }
+        case DataType::INT32: {
+            return ExecCompareVisitorImpl<L, int32_t>(expr, op);
+        }
+        case DataType::INT64: {
+            return ExecCompareVisitorImpl<L, int64_t>(expr, op);
+        }
+        case DataType::FLOAT: {
+            return ExecCompareVisitorImpl<L, float>(expr, op);
+        }
+        case DataType::DOUBLE: {
+            return ExecCompareVisitorImpl<L, double>(expr, op);
+        }
+        default:
+            PanicInfo("unsupported datatype");
     }
-};
+}
 
+// resolve the type pair once per expression, so that the kernel runs on typed columns
 template <typename Op>
 auto
 ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> RetType {
-    using number = boost::variant<bool, int8_t, int16_t, int32_t, int64_t, float, double>;
-    auto size_per_chunk = segment_.size_per_chunk();
-    auto num_chunk = upper_div(row_count_, size_per_chunk);
-    std::deque<RetType> bitsets;
-    for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
-        auto size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
-        auto getChunkData = [&, chunk_id](DataType type, FieldOffset offset) -> std::function<const number(int)> {
-            switch (type) {
-                case DataType::BOOL: {
-                    auto chunk_data = segment_.chunk_data<bool>(offset, chunk_id).data();
-                    return [chunk_data](int i) -> const number { return chunk_data[i]; };
-                }
-                case DataType::INT8: {
-                    auto chunk_data = segment_.chunk_data<int8_t>(offset, chunk_id).data();
-                    return [chunk_data](int i) -> const number { return chunk_data[i]; };
-                }
-                case DataType::INT16: {
-                    auto chunk_data = segment_.chunk_data<int16_t>(offset, chunk_id).data();
-                    return [chunk_data](int i) -> const number { return chunk_data[i]; };
-                }
-                case DataType::INT32: {
-                    auto chunk_data = segment_.chunk_data<int32_t>(offset, chunk_id).data();
-                    return [chunk_data](int i) -> const number { return chunk_data[i]; };
-                }
-                case DataType::INT64: {
-                    auto chunk_data = segment_.chunk_data<int64_t>(offset, chunk_id).data();
-                    return [chunk_data](int i) -> const number { return chunk_data[i]; };
-                }
-                case DataType::FLOAT: {
-                    auto chunk_data = segment_.chunk_data<float>(offset, chunk_id).data();
-                    return [chunk_data](int i) -> const number { return chunk_data[i]; };
-                }
-                case DataType::DOUBLE: {
-                    auto chunk_data = segment_.chunk_data<double>(offset, chunk_id).data();
-                    return [chunk_data](int i) -> const number { return chunk_data[i]; };
-                }
-                default:
-                    PanicInfo("unsupported datatype");
-            }
-        };
-        auto left = getChunkData(expr.left_data_type_, expr.left_field_offset_);
-        auto right = getChunkData(expr.right_data_type_, expr.right_field_offset_);
-
-        boost::dynamic_bitset<> bitset(size);
-        for (int i = 0; i < size; ++i) {
-            bool is_in = boost::apply_visitor(relational<decltype(op)>{}, left(i), right(i));
-            bitset[i] = is_in;
+    switch (expr.left_data_type_) {
+        case DataType::BOOL: {
+            return ExecCompareRightDispatcher<bool>(expr, op);
+        }
+        case DataType::INT8: {
+            return ExecCompareRightDispatcher<int8_t>(expr, op);
+        }
+        case DataType::INT16: {
+            return ExecCompareRightDispatcher<int16_t>(expr, op);
+        }
+        case DataType::INT32: {
+            return ExecCompareRightDispatcher<int32_t>(expr, op);
         }
-        bitsets.emplace_back(std::move(bitset));
+        case DataType::INT64: {
+            return ExecCompareRightDispatcher<int64_t>(expr, op);
+        }
+        case DataType::FLOAT: {
+            return ExecCompareRightDispatcher<float>(expr, op);
+        }
+        case DataType::DOUBLE: {
+            return ExecCompareRightDispatcher<double>(expr, op);
+        }
+        default:
+            PanicInfo("unsupported datatype");
     }
-    auto final_result = Assemble(bitsets);
-    Assert(final_result.size() == row_count_);
-    return final_result;
 }
 
 void
@@ -462,21 +567,14 @@ ExecExprVisitor::ExecTermVisitorImpl(TermExpr& expr_raw) -> RetType {
     auto field_offset = expr_raw.field_offset_;
     auto& field_meta = schema[field_offset];
     auto size_per_chunk = segment_.size_per_chunk();
-    auto num_chunk = upper_div(row_count_, size_per_chunk);
-    std::deque<RetType> bitsets;
     std::sort(expr.terms_.begin(), expr.terms_.end());
-    for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+    auto& terms = expr.terms_;
+    auto is_in = [&terms](T value) { return std::binary_search(terms.begin(), terms.end(), value); };
+    auto fill_chunk = [&](int64_t chunk_id, int64_t size, uint64_t* words, const uint64_t* mask) {
         Span<T> chunk = segment_.chunk_data<T>(field_offset, chunk_id);
-        auto size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
-        boost::dynamic_bitset<> bitset(size);
-        for (int i = 0; i < size; ++i) {
-            auto value = chunk.data()[i];
-            bool is_in = std::binary_search(expr.terms_.begin(), expr.terms_.end(), value);
-            bitset[i] = is_in;
-        }
-        bitsets.emplace_back(std::move(bitset));
-    }
-    auto final_result = Assemble(bitsets);
+        UnaryPredicateKernel(chunk.data(), size, is_in, words, mask);
+    };
+    auto final_result = ExecByChunk(row_count_, size_per_chunk, mask_, fill_chunk);
     Assert(final_result.size() == row_count_);
     return final_result;
 }
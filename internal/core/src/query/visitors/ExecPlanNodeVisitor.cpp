@@ -136,7 +136,10 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
 
     segment->mask_with_timestamps(bitset_holder, timestamp_);
 
-    auto seg_offsets = std::move(segment->search_ids(bitset_holder, MAX_TIMESTAMP));
+    // the offset is global, skipping it here would drop rows that other segments' matches push past it
+    auto limit = node.limit_ > std::numeric_limits<int64_t>::max() - node.offset_ ? std::numeric_limits<int64_t>::max()
+                                                                                  : node.offset_ + node.limit_;
+    auto seg_offsets = std::move(segment->search_ids(bitset_holder, MAX_TIMESTAMP, 0, limit));
     ret.result_offsets_.assign((int64_t*)seg_offsets.data(), (int64_t*)seg_offsets.data() + seg_offsets.size());
     retrieve_ret_ = ret;
 }
@@ -10,10 +10,11 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #pragma once
-#include <shared_mutex>
-#include <mutex>
-#include <set>
+#include <algorithm>
 #include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
 namespace milvus::segcore {
 
 // determined the largest number `ack` where
@@ -37,18 +38,35 @@ example() {
     auto ack4 = acker.GetAck();  // get 20, since acker has { [0, 20) }
 }
 #endif
+// segments completed in order only take a CAS on the ack, which is the common case.
+// a segment completed ahead of the ack waits in a small pending list under the mutex,
+// and whoever moves the ack drains the pending segments that become consecutive.
 class AckResponder {
  public:
+    AckResponder() {
+        pending_.reserve(64);
+    }
+
     // specify that segment [seg_begin, seg_end) has been processed
     // WARN: segments shouldn't overlap
     void
     AddSegment(int64_t seg_begin, int64_t seg_end) {
-        std::lock_guard lck(mutex_);
-        fetch_and_flip(seg_end);
-        auto old_begin = fetch_and_flip(seg_begin);
-        if (old_begin) {
-            minimum_ = *acks_.begin();
+        if (seg_begin == seg_end) {
+            return;
+        }
+        auto expected = seg_begin;
+        if (minimum_.compare_exchange_strong(expected, seg_end)) {
+            if (pending_count_.load() == 0) {
+                return;
+            }
+            std::lock_guard lck(mutex_);
+            drain();
+            return;
         }
+        std::lock_guard lck(mutex_);
+        pending_.emplace_back(seg_begin, seg_end);
+        pending_count_.fetch_add(1);
+        drain();
     }
 
     // return ack
@@ -58,20 +76,29 @@ class AckResponder {
     }
 
  private:
-    bool
-    fetch_and_flip(int64_t endpoint) {
-        if (acks_.count(endpoint)) {
-            acks_.erase(endpoint);
-            return true;
-        } else {
-            acks_.insert(endpoint);
-            return false;
+    // move the ack over the pending segments starting at it, with mutex_ held
+    void
+    drain() {
+        while (true) {
+            auto ack = minimum_.load();
+            auto iter = std::find_if(pending_.begin(), pending_.end(),
+                                     [ack](const std::pair<int64_t, int64_t>& seg) { return seg.first == ack; });
+            if (iter == pending_.end()) {
+                return;
+            }
+            // only the owner of the segment starting at ack may move it, which is pending here
+            auto seg_end = iter->second;
+            *iter = pending_.back();
+            pending_.pop_back();
+            pending_count_.fetch_sub(1);
+            minimum_.store(seg_end);
         }
     }
 
  private:
-    std::shared_mutex mutex_;
-    std::set<int64_t> acks_ = {0};
+    std::mutex mutex_;
+    std::vector<std::pair<int64_t, int64_t>> pending_;
+    std::atomic<int64_t> pending_count_ = 0;
     std::atomic<int64_t> minimum_ = 0;
 };
 }  // namespace milvus::segcore
@@ -0,0 +1,117 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#pragma once
+#include <cstring>
+#include <functional>
+#include <utility>
+
+#include "common/Types.h"
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::segcore {
+// raw data of a sealed column, either an owned copy or a view of memory
+// handed over by the loader (e.g. a mmapped file), released on destruction
+class ColumnData {
+ public:
+    ColumnData() = default;
+
+    static ColumnData
+    Copy(const void* data, int64_t size) {
+        ColumnData column;
+        column.owned_.resize(size);
+        if (size) {
+            memcpy(column.owned_.data(), data, size);
+        }
+        column.data_ = column.owned_.data();
+        column.size_ = size;
+        return column;
+    }
+
+    // release is called exactly once when the column is dropped
+    static ColumnData
+    View(const void* data, int64_t size, std::function<void()> release) {
+        AssertInfo(data != nullptr, "view of null data");
+        ColumnData column;
+        column.data_ = reinterpret_cast<const char*>(data);
+        column.size_ = size;
+        column.release_ = std::move(release);
+        return column;
+    }
+
+    ColumnData(ColumnData&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    ColumnData&
+    operator=(ColumnData&& other) noexcept {
+        if (this != &other) {
+            reset();
+            owned_ = std::move(other.owned_);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            release_ = std::exchange(other.release_, nullptr);
+        }
+        return *this;
+    }
+
+    ColumnData(const ColumnData&) = delete;
+
+    ColumnData&
+    operator=(const ColumnData&) = delete;
+
+    ~ColumnData() {
+        reset();
+    }
+
+    const char*
+    data() const {
+        return data_;
+    }
+
+    template <typename T>
+    const T*
+    get() const {
+        return reinterpret_cast<const T*>(data_);
+    }
+
+    // in bytes
+    int64_t
+    size() const {
+        return size_;
+    }
+
+    bool
+    empty() const {
+        return data_ == nullptr;
+    }
+
+ private:
+    void
+    reset() {
+        if (release_) {
+            release_();
+            release_ = nullptr;
+        }
+        owned_.clear();
+        owned_.shrink_to_fit();
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+ private:
+    aligned_vector<char> owned_;
+    const char* data_ = nullptr;
+    int64_t size_ = 0;
+    std::function<void()> release_;
+};
+}  // namespace milvus::segcore
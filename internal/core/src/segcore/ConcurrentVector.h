@@ -14,9 +14,8 @@
 
 #include <atomic>
 #include <cassert>
-#include <deque>
+#include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <vector>
 #include <utility>
 #include "exceptions/EasyAssert.h"
@@ -30,44 +29,95 @@ namespace milvus::segcore {
 template <typename Type>
 using FixedVector = boost::container::vector<Type>;
 
+// append-only vector, elements never move once constructed.
+// elements live in buckets of geometrically growing size, bucket k holds 2^k elements,
+// so locating an element is O(1) and readers never take a lock.
+// a writer constructs elements under the mutex and publishes them by a release store of size_.
 template <typename Type>
 class ThreadSafeVector {
  public:
+    ThreadSafeVector() = default;
+    ThreadSafeVector(const ThreadSafeVector&) = delete;
+    ThreadSafeVector&
+    operator=(const ThreadSafeVector&) = delete;
+
+    ~ThreadSafeVector() {
+        auto size = size_.load(std::memory_order_acquire);
+        for (int64_t index = 0; index < size; ++index) {
+            element_at(index).~Type();
+        }
+        for (int bucket_id = 0; bucket_id < MAX_BUCKETS; ++bucket_id) {
+            auto bucket = buckets_[bucket_id].load(std::memory_order_acquire);
+            if (bucket != nullptr) {
+                std::allocator<Type>().deallocate(bucket, bucket_capacity(bucket_id));
+            }
+        }
+    }
+
     template <typename... Args>
     void
     emplace_to_at_least(int64_t size, Args... args) {
-        if (size <= size_) {
+        if (size <= size_.load(std::memory_order_acquire)) {
             return;
         }
         std::lock_guard lck(mutex_);
-        while (vec_.size() < size) {
-            vec_.emplace_back(std::forward<Args...>(args...));
-            ++size_;
+        auto current = size_.load(std::memory_order_relaxed);
+        while (current < size) {
+            auto [bucket_id, bucket_offset] = locate(current);
+            auto bucket = buckets_[bucket_id].load(std::memory_order_relaxed);
+            if (bucket == nullptr) {
+                bucket = std::allocator<Type>().allocate(bucket_capacity(bucket_id));
+                buckets_[bucket_id].store(bucket, std::memory_order_release);
+            }
+            new (bucket + bucket_offset) Type(args...);
+            ++current;
+            size_.store(current, std::memory_order_release);
         }
     }
+
     const Type&
     operator[](int64_t index) const {
-        Assert(index < size_);
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        Assert(index < size_.load(std::memory_order_acquire));
+        return element_at(index);
     }
 
     Type&
     operator[](int64_t index) {
-        Assert(index < size_);
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        Assert(index < size_.load(std::memory_order_acquire));
+        return element_at(index);
     }
 
     int64_t
     size() const {
-        return size_;
+        return size_.load(std::memory_order_acquire);
+    }
+
+ private:
+    static constexpr int MAX_BUCKETS = 48;
+
+    static int64_t
+    bucket_capacity(int bucket_id) {
+        return int64_t(1) << bucket_id;
+    }
+
+    // element i lives in bucket floor(log2(i + 1)), at offset i + 1 - 2^bucket_id
+    static std::pair<int, int64_t>
+    locate(int64_t index) {
+        auto pos = static_cast<uint64_t>(index) + 1;
+        int bucket_id = 63 - __builtin_clzll(pos);
+        return {bucket_id, static_cast<int64_t>(pos - (uint64_t(1) << bucket_id))};
+    }
+
+    Type&
+    element_at(int64_t index) const {
+        auto [bucket_id, bucket_offset] = locate(index);
+        return buckets_[bucket_id].load(std::memory_order_acquire)[bucket_offset];
     }
 
  private:
     std::atomic<int64_t> size_ = 0;
-    std::deque<Type> vec_;
-    mutable std::shared_mutex mutex_;
+    std::atomic<Type*> buckets_[MAX_BUCKETS] = {};
+    std::mutex mutex_;
 };
 
 class VectorBase {
@@ -85,6 +135,10 @@ class VectorBase {
     virtual SpanBase
     get_span_base(int64_t chunk_id) const = 0;
 
+    // bytes of the allocated chunks
+    virtual int64_t
+    memory_usage_in_bytes() const = 0;
+
     int64_t
     get_size_per_chunk() const {
         return size_per_chunk_;
@@ -209,6 +263,11 @@ class ConcurrentVectorImpl : public VectorBase {
         return chunks_.size();
     }
 
+    int64_t
+    memory_usage_in_bytes() const override {
+        return num_chunk() * size_per_chunk_ * Dim * sizeof(Type);
+    }
+
  private:
     void
     fill_chunk(
@@ -14,27 +14,63 @@
 #include "AckResponder.h"
 #include "common/Schema.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
+#include "faiss/utils/BitsetView.h"
 #include <utility>
 #include <memory>
+#include <vector>
 #include "segcore/Record.h"
 
 namespace milvus::segcore {
 
 struct DeletedRecord {
+    // a version of the delete bitmap, which is split into chunks of bitmap_size_per_chunk bits.
+    // versions share unchanged chunks, a new version only copies the chunks it changes.
+    // nullptr stands for a chunk without any delete.
     struct TmpBitmap {
+        using Chunk = faiss::ConcurrentBitset;
+
         // Just for query
         int64_t del_barrier = 0;
-        faiss::ConcurrentBitsetPtr bitmap_ptr;
+        int64_t insert_barrier = 0;
+        std::vector<std::shared_ptr<const Chunk>> chunks;
 
+        bool
+        test(int64_t offset) const {
+            if (offset >= insert_barrier) {
+                return false;
+            }
+            auto& chunk = chunks[offset / bitmap_size_per_chunk];
+            return chunk != nullptr && faiss::BitsetView(*chunk).test(offset % bitmap_size_per_chunk);
+        }
+
+        // a new version sharing all chunks with this one
         std::shared_ptr<TmpBitmap>
-        clone(int64_t capacity);
+        clone(int64_t insert_barrier) const;
+
+        // only valid on a version which is not published yet
+        void
+        set(int64_t offset) {
+            mutable_chunk(offset / bitmap_size_per_chunk).set(offset % bitmap_size_per_chunk);
+        }
+
+        void
+        clear(int64_t offset) {
+            mutable_chunk(offset / bitmap_size_per_chunk).clear(offset % bitmap_size_per_chunk);
+        }
+
+     private:
+        Chunk&
+        mutable_chunk(int64_t chunk_id);
+
+        // chunks copied by this version, which are not shared with any other version
+        std::vector<bool> owned_;
     };
     static constexpr int64_t deprecated_size_per_chunk = 32 * 1024;
+    static constexpr int64_t bitmap_size_per_chunk = 64 * 1024;
     DeletedRecord()
         : lru_(std::make_shared<TmpBitmap>()),
           timestamps_(deprecated_size_per_chunk),
           uids_(deprecated_size_per_chunk) {
-        lru_->bitmap_ptr = std::make_shared<faiss::ConcurrentBitset>(0);
     }
 
     auto
@@ -47,7 +83,7 @@ struct DeletedRecord {
     insert_lru_entry(std::shared_ptr<TmpBitmap> new_entry, bool force = false) {
         std::lock_guard lck(shared_mutex_);
         if (new_entry->del_barrier <= lru_->del_barrier) {
-            if (!force || new_entry->bitmap_ptr->count() <= lru_->bitmap_ptr->count()) {
+            if (!force || new_entry->insert_barrier <= lru_->insert_barrier) {
                 // DO NOTHING
                 return;
             }
@@ -55,6 +91,19 @@ struct DeletedRecord {
         lru_ = std::move(new_entry);
     }
 
+    // deleted pks and timestamps, plus the chunks of the latest bitmap
+    int64_t
+    memory_usage_in_bytes() const {
+        int64_t total_bytes = timestamps_.memory_usage_in_bytes() + uids_.memory_usage_in_bytes();
+        std::shared_lock lck(shared_mutex_);
+        for (auto& chunk : lru_->chunks) {
+            if (chunk != nullptr) {
+                total_bytes += chunk->size();
+            }
+        }
+        return total_bytes;
+    }
+
  public:
     std::atomic<int64_t> reserved = 0;
     AckResponder ack_responder_;
@@ -63,17 +112,33 @@ struct DeletedRecord {
 
  private:
     std::shared_ptr<TmpBitmap> lru_;
-    std::shared_mutex shared_mutex_;
+    mutable std::shared_mutex shared_mutex_;
 };
 
 inline auto
-DeletedRecord::TmpBitmap::clone(int64_t capacity) -> std::shared_ptr<TmpBitmap> {
+DeletedRecord::TmpBitmap::clone(int64_t insert_barrier) const -> std::shared_ptr<TmpBitmap> {
     auto res = std::make_shared<TmpBitmap>();
     res->del_barrier = this->del_barrier;
-    res->bitmap_ptr = std::make_shared<faiss::ConcurrentBitset>(capacity);
-    auto u8size = this->bitmap_ptr->size();
-    memcpy(res->bitmap_ptr->mutable_data(), res->bitmap_ptr->data(), u8size);
+    res->insert_barrier = insert_barrier;
+    res->chunks = this->chunks;
+    res->chunks.resize(upper_div(insert_barrier, bitmap_size_per_chunk));
+    res->owned_.resize(res->chunks.size(), false);
     return res;
 }
 
+inline auto
+DeletedRecord::TmpBitmap::mutable_chunk(int64_t chunk_id) -> Chunk& {
+    Assert(chunk_id < chunks.size());
+    if (!owned_[chunk_id]) {
+        // copy on write
+        auto chunk = std::make_shared<Chunk>(bitmap_size_per_chunk);
+        if (chunks[chunk_id] != nullptr) {
+            memcpy(chunk->mutable_data(), chunks[chunk_id]->data(), chunk->size());
+        }
+        chunks[chunk_id] = chunk;
+        owned_[chunk_id] = true;
+    }
+    return const_cast<Chunk&>(*chunks[chunk_id]);
+}
+
 }  // namespace milvus::segcore
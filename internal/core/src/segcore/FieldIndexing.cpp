@@ -15,6 +15,8 @@
 #include <knowhere/index/vector_index/adapter/VectorAdapter.h>
 #include <string>
 #include "common/SystemProperty.h"
+#include "segcore/IndexingExecutor.h"
+#include "utils/Log.h"
 
 namespace milvus::segcore {
 void
@@ -35,6 +37,7 @@ VectorFieldIndexing::BuildIndexRange(int64_t ack_beg, int64_t ack_end, const Vec
         auto dataset = knowhere::GenDataset(source->get_size_per_chunk(), dim, chunk.data());
         indexing->Train(dataset, conf);
         indexing->AddWithoutIds(dataset, conf);
+        memory_usage_ += IndexMemoryUsage(*indexing, source->get_size_per_chunk() * dim * sizeof(float));
         data_[chunk_id] = std::move(indexing);
     }
 }
@@ -87,13 +90,57 @@ IndexingRecord::UpdateResourceAck(int64_t chunk_ack, const InsertRecord& record)
     resource_ack_ = chunk_ack;
     lck.unlock();
 
-    //    std::thread([this, old_ack, chunk_ack, &record] {
+    for (auto chunk_id = old_ack; chunk_id < chunk_ack; ++chunk_id) {
+        {
+            std::lock_guard pending_lck(pending_mutex_);
+            ++pending_builds_;
+        }
+        IndexingExecutor::GetInstance().Submit([this, chunk_id, &record] {
+            if (!cancelled_) {
+                BuildChunk(chunk_id, record);
+            }
+            FinishPendingBuild();
+        });
+    }
+}
+
+void
+IndexingRecord::BuildChunk(int64_t chunk_id, const InsertRecord& record) {
     for (auto& [field_offset, entry] : field_indexings_) {
         auto vec_base = record.get_field_data_base(field_offset);
-        entry->BuildIndexRange(old_ack, chunk_ack, vec_base);
+        for (int attempt = 1;; ++attempt) {
+            try {
+                entry->BuildIndexRange(chunk_id, chunk_id + 1, vec_base);
+                break;
+            } catch (std::exception& e) {
+                if (attempt < MAX_BUILD_ATTEMPTS) {
+                    LOG_SERVER_WARNING_ << "retry small index of field " << field_offset.get() << " chunk "
+                                        << chunk_id << ": " << e.what();
+                    continue;
+                }
+                // the chunk keeps no index of this field, readers fall back to its raw data
+                LOG_SERVER_ERROR_ << "failed to build small index of field " << field_offset.get() << " chunk "
+                                  << chunk_id << ": " << e.what();
+                break;
+            }
+        }
     }
-    finished_ack_.AddSegment(old_ack, chunk_ack);
-    //    }).detach();
+    // chunks may finish out of order, ack covers the consecutive prefix only.
+    // a chunk is acked even if its build failed, otherwise no later chunk would ever be indexed
+    finished_ack_.AddSegment(chunk_id, chunk_id + 1);
+}
+
+void
+IndexingRecord::FinishPendingBuild() {
+    std::lock_guard lck(pending_mutex_);
+    --pending_builds_;
+    pending_cond_.notify_all();
+}
+
+void
+IndexingRecord::WaitForPendingBuilds() const {
+    std::unique_lock lck(pending_mutex_);
+    pending_cond_.wait(lck, [this] { return pending_builds_ == 0; });
 }
 
 template <typename T>
@@ -110,6 +157,7 @@ ScalarFieldIndexing<T>::BuildIndexRange(int64_t ack_beg, int64_t ack_end, const
         // TODO
         auto indexing = std::make_unique<knowhere::scalar::StructuredIndexSort<T>>();
         indexing->Build(vec_base->get_size_per_chunk(), chunk.data());
+        memory_usage_ += indexing->Size();
         data_[chunk_id] = std::move(indexing);
     }
 }
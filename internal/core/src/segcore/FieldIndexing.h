@@ -16,10 +16,12 @@
 #include <optional>
 #include <map>
 #include <memory>
+#include <condition_variable>
 #include "InsertRecord.h"
 #include <knowhere/index/vector_index/IndexIVF.h>
 #include <knowhere/index/structured_index_simple/StructuredIndexSort.h>
 #include "segcore/SegcoreConfig.h"
+#include "segcore/MemoryUsage.h"
 
 namespace milvus::segcore {
 
@@ -51,10 +53,17 @@ class FieldIndexing {
     virtual knowhere::Index*
     get_chunk_indexing(int64_t chunk_id) const = 0;
 
+    // bytes of the chunk indexes built so far
+    int64_t
+    get_memory_usage_in_bytes() const {
+        return memory_usage_;
+    }
+
  protected:
     // additional info
     const FieldMeta& field_meta_;
     const SegcoreConfig& segcore_config_;
+    std::atomic<int64_t> memory_usage_ = 0;
 };
 template <typename T>
 class ScalarFieldIndexing : public FieldIndexing {
@@ -68,7 +77,8 @@ class ScalarFieldIndexing : public FieldIndexing {
     knowhere::scalar::StructuredIndex<T>*
     get_chunk_indexing(int64_t chunk_id) const override {
         Assert(!field_meta_.is_vector());
-        return data_.at(chunk_id).get();
+        // null for a chunk whose build failed
+        return chunk_id < data_.size() ? data_[chunk_id].get() : nullptr;
     }
 
  private:
@@ -86,7 +96,8 @@ class VectorFieldIndexing : public FieldIndexing {
     knowhere::VecIndex*
     get_chunk_indexing(int64_t chunk_id) const override {
         Assert(field_meta_.is_vector());
-        return data_.at(chunk_id).get();
+        // null for a chunk whose build failed
+        return chunk_id < data_.size() ? data_[chunk_id].get() : nullptr;
     }
 
     knowhere::Config
@@ -109,6 +120,12 @@ class IndexingRecord {
         Initialize();
     }
 
+    // cancel the builds not started yet, and wait for the running ones
+    ~IndexingRecord() {
+        cancelled_ = true;
+        WaitForPendingBuilds();
+    }
+
     void
     Initialize() {
         int offset_id = 0;
@@ -133,10 +150,16 @@ class IndexingRecord {
     }
 
     // concurrent, reentrant
+    // schedule small index building of new chunks on IndexingExecutor,
+    // finished_ack advances when the consecutive chunks are built
     void
     UpdateResourceAck(int64_t chunk_ack, const InsertRecord& record);
 
-    // concurrent
+    // block until all scheduled builds are done or cancelled
+    void
+    WaitForPendingBuilds() const;
+
+    // concurrent, chunks below the ack whose build failed have a null chunk indexing
     int64_t
     get_finished_ack() const {
         return finished_ack_.GetAck();
@@ -161,6 +184,18 @@ class IndexingRecord {
         return field_indexings_.count(field_offset);
     }
 
+    // bytes of the small indexes of vector or scalar fields
+    int64_t
+    get_memory_usage_in_bytes(bool is_vector) const {
+        int64_t total_bytes = 0;
+        for (auto& [field_offset, entry] : field_indexings_) {
+            if (schema_[field_offset].is_vector() == is_vector) {
+                total_bytes += entry->get_memory_usage_in_bytes();
+            }
+        }
+        return total_bytes;
+    }
+
     template <typename T>
     auto
     get_scalar_field_indexing(FieldOffset field_offset) const -> const ScalarFieldIndexing<T>& {
@@ -170,17 +205,32 @@ class IndexingRecord {
         return *ptr;
     }
 
+ private:
+    void
+    BuildChunk(int64_t chunk_id, const InsertRecord& record);
+
+    void
+    FinishPendingBuild();
+
  private:
     const Schema& schema_;
     const SegcoreConfig& segcore_config_;
 
  private:
+    static constexpr int MAX_BUILD_ATTEMPTS = 3;
+
     // control info
     std::atomic<int64_t> resource_ack_ = 0;
     //    std::atomic<int64_t> finished_ack_ = 0;
     AckResponder finished_ack_;
     std::mutex mutex_;
 
+    // background builds
+    std::atomic<bool> cancelled_ = false;
+    mutable std::mutex pending_mutex_;
+    mutable std::condition_variable pending_cond_;
+    int64_t pending_builds_ = 0;
+
  private:
     // field_offset => indexing
     std::map<FieldOffset, std::unique_ptr<FieldIndexing>> field_indexings_;
@@ -0,0 +1,61 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#include "segcore/IndexingExecutor.h"
+#include <utility>
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::segcore {
+
+IndexingExecutor&
+IndexingExecutor::GetInstance() {
+    static IndexingExecutor executor;
+    return executor;
+}
+
+void
+IndexingExecutor::SetThreadNum(int64_t thread_num) {
+    AssertInfo(thread_num >= 0, "thread num of indexing executor should be non-negative");
+    ThreadPoolPtr new_pool;
+    if (thread_num > 0) {
+        new_pool = std::make_shared<ThreadPool>(thread_num, thread_num * max_pending_per_thread_);
+    }
+
+    std::unique_lock lck(mutex_);
+    auto old_pool = std::move(pool_);
+    pool_ = std::move(new_pool);
+    thread_num_ = thread_num;
+    lck.unlock();
+
+    if (old_pool) {
+        old_pool->Stop();
+    }
+}
+
+int64_t
+IndexingExecutor::GetThreadNum() const {
+    std::shared_lock lck(mutex_);
+    return thread_num_;
+}
+
+void
+IndexingExecutor::Submit(std::function<void()> task) {
+    std::shared_lock lck(mutex_);
+    if (!pool_) {
+        lck.unlock();
+        task();
+        return;
+    }
+    pool_->enqueue(std::move(task));
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,56 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include "utils/ThreadPool.h"
+
+namespace milvus::segcore {
+
+// process-wide executor building small indexes of growing segments in background
+// with zero thread, tasks run synchronously in the submitting thread
+class IndexingExecutor {
+ public:
+    static IndexingExecutor&
+    GetInstance();
+
+    IndexingExecutor(const IndexingExecutor&) = delete;
+    IndexingExecutor&
+    operator=(const IndexingExecutor&) = delete;
+
+    // pending tasks are drained by the old pool before it is released
+    void
+    SetThreadNum(int64_t thread_num);
+
+    int64_t
+    GetThreadNum() const;
+
+    // block when the pending queue is full, to throttle inserters
+    void
+    Submit(std::function<void()> task);
+
+ private:
+    IndexingExecutor() = default;
+
+ private:
+    // bound of pending tasks per worker thread
+    static constexpr int64_t max_pending_per_thread_ = 4;
+
+    mutable std::shared_mutex mutex_;
+    int64_t thread_num_ = 0;
+    ThreadPoolPtr pool_;
+};
+
+}  // namespace milvus::segcore
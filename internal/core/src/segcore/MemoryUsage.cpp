@@ -0,0 +1,32 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/MemoryUsage.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+
+namespace milvus::segcore {
+
+int64_t
+IndexMemoryUsage(knowhere::Index& index, int64_t fallback_size) {
+    auto vec_index = dynamic_cast<knowhere::VecIndex*>(&index);
+    if (vec_index == nullptr) {
+        return index.Size();
+    }
+    try {
+        vec_index->UpdateIndexSize();
+        return vec_index->Size();
+    } catch (std::exception&) {
+        // indexes such as IDMAP keep no size of their own
+        return fallback_size + vec_index->UidsSize();
+    }
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,45 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstdint>
+#include "knowhere/index/Index.h"
+
+namespace milvus::segcore {
+
+// bytes held by a segment, by category
+struct MemoryUsage {
+    // columns of user fields
+    int64_t field_data = 0;
+    // row ids and timestamps
+    int64_t system_field_data = 0;
+    int64_t vector_index = 0;
+    int64_t scalar_index = 0;
+    int64_t primary_key_index = 0;
+    int64_t timestamp_index = 0;
+    // deleted pks, their timestamps and the delete bitmap
+    int64_t delete_record = 0;
+    // bitmaps kept around for reuse
+    int64_t cache = 0;
+
+    int64_t
+    total() const {
+        return field_data + system_field_data + vector_index + scalar_index + primary_key_index + timestamp_index +
+               delete_record + cache;
+    }
+};
+
+// size of a built index, fallback_size is used when the index cannot tell
+int64_t
+IndexMemoryUsage(knowhere::Index& index, int64_t fallback_size);
+
+}  // namespace milvus::segcore
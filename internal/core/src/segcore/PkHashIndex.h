@@ -0,0 +1,166 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// primary key -> offsets of a growing segment, a key may have several offsets
+// open addressing with linear probing over one flat array, each (key, offset) pair takes a slot,
+// the table is kept at most half full, inserts and lookups run concurrently under a shared lock,
+// only growing the table takes the exclusive one
+class PkHashIndex {
+ public:
+    PkHashIndex() {
+        rehash(kInitialCapacity);
+    }
+
+    PkHashIndex(const PkHashIndex&) = delete;
+
+    PkHashIndex&
+    operator=(const PkHashIndex&) = delete;
+
+    // ids[i] -> base + i
+    void
+    insert(const idx_t* ids, int64_t count, int64_t base) {
+        reserve(count);
+        std::shared_lock lck(mutex_);
+        for (int64_t i = 0; i < count; ++i) {
+            insert_one(ids[i], base + i);
+        }
+        size_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    // calls fn(i, offset) for every offset of ids[i]
+    template <typename Fn>
+    void
+    for_each_offset(const idx_t* ids, int64_t count, Fn&& fn) const {
+        std::shared_lock lck(mutex_);
+        for (int64_t i = 0; i < count; ++i) {
+            auto id = ids[i];
+            for (auto pos = static_cast<int64_t>(hash(id) & mask_);; pos = (pos + 1) & mask_) {
+                auto& slot = slots_[pos];
+                auto offset = slot.offset.load(std::memory_order_acquire);
+                if (offset == kEmpty) {
+                    break;
+                }
+                // a claimed slot is not published yet, skip it
+                if (offset >= 0 && slot.key.load(std::memory_order_relaxed) == id) {
+                    fn(i, offset);
+                }
+            }
+        }
+    }
+
+    int64_t
+    size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    memory_usage_in_bytes() const {
+        std::shared_lock lck(mutex_);
+        return (mask_ + 1) * sizeof(Slot);
+    }
+
+ private:
+    struct Slot {
+        std::atomic<idx_t> key;
+        std::atomic<int64_t> offset;
+    };
+
+    static constexpr int64_t kEmpty = -1;
+    static constexpr int64_t kClaimed = -2;
+    static constexpr int64_t kInitialCapacity = 1024;
+
+    static uint64_t
+    hash(idx_t id) {
+        // ids are often sequential, mix them before masking
+        auto x = static_cast<uint64_t>(id);
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    void
+    insert_one(idx_t id, int64_t offset) {
+        for (auto pos = static_cast<int64_t>(hash(id) & mask_);; pos = (pos + 1) & mask_) {
+            auto& slot = slots_[pos];
+            auto expected = kEmpty;
+            if (slot.offset.load(std::memory_order_relaxed) == kEmpty &&
+                slot.offset.compare_exchange_strong(expected, kClaimed, std::memory_order_acq_rel)) {
+                slot.key.store(id, std::memory_order_relaxed);
+                slot.offset.store(offset, std::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    // make room for count more entries, counting the ones other inserters have reserved
+    void
+    reserve(int64_t count) {
+        auto needed = reserved_.fetch_add(count, std::memory_order_relaxed) + count;
+        {
+            std::shared_lock lck(mutex_);
+            if (needed * 2 <= mask_ + 1) {
+                return;
+            }
+        }
+        std::unique_lock lck(mutex_);
+        auto capacity = mask_ + 1;
+        needed = reserved_.load(std::memory_order_relaxed);
+        while (needed * 2 > capacity) {
+            capacity *= 2;
+        }
+        if (capacity != mask_ + 1) {
+            rehash(capacity);
+        }
+    }
+
+    // needs the exclusive lock, or no concurrent access at all
+    void
+    rehash(int64_t capacity) {
+        auto old_capacity = slots_ ? mask_ + 1 : 0;
+        auto old_slots = std::move(slots_);
+        slots_ = std::make_unique<Slot[]>(capacity);
+        for (int64_t i = 0; i < capacity; ++i) {
+            slots_[i].key.store(0, std::memory_order_relaxed);
+            slots_[i].offset.store(kEmpty, std::memory_order_relaxed);
+        }
+        mask_ = capacity - 1;
+        for (int64_t i = 0; i < old_capacity; ++i) {
+            auto offset = old_slots[i].offset.load(std::memory_order_relaxed);
+            if (offset >= 0) {
+                insert_one(old_slots[i].key.load(std::memory_order_relaxed), offset);
+            }
+        }
+    }
+
+ private:
+    mutable std::shared_mutex mutex_;
+    std::unique_ptr<Slot[]> slots_;
+    int64_t mask_ = 0;
+    std::atomic<int64_t> size_ = 0;
+    std::atomic<int64_t> reserved_ = 0;
+};
+
+}  // namespace milvus::segcore
@@ -23,33 +23,11 @@ merge_into(int64_t queries,
            int64_t* uids,
            const float* new_distances,
            const int64_t* new_uids) {
+    // new results go first on ties
+    auto before = [](float new_dis, float dis) { return new_dis <= dis; };
     for (int64_t qn = 0; qn < queries; ++qn) {
         auto base = qn * topk;
-        auto src2_dis = distances + base;
-        auto src2_uids = uids + base;
-
-        auto src1_dis = new_distances + base;
-        auto src1_uids = new_uids + base;
-
-        std::vector<float> buf_dis(topk);
-        std::vector<int64_t> buf_uids(topk);
-
-        auto it1 = 0;
-        auto it2 = 0;
-
-        for (auto buf = 0; buf < topk; ++buf) {
-            if (src1_dis[it1] <= src2_dis[it2]) {
-                buf_dis[buf] = src1_dis[it1];
-                buf_uids[buf] = src1_uids[it1];
-                ++it1;
-            } else {
-                buf_dis[buf] = src2_dis[it2];
-                buf_uids[buf] = src2_uids[it2];
-                ++it2;
-            }
-        }
-        std::copy_n(buf_dis.data(), topk, src2_dis);
-        std::copy_n(buf_uids.data(), topk, src2_uids);
+        merge_topk_inplace(topk, distances + base, uids + base, new_distances + base, new_uids + base, before);
     }
     return Status::OK();
 }
@@ -17,6 +17,48 @@
 #include "utils/Status.h"
 
 namespace milvus::segcore {
+
+// merge the sorted topk of src into the sorted topk of dst in place, without any buffer.
+// before(src_value, dst_value) tells whether an element of src goes before an element of dst.
+// the number of src elements which make it into the new topk is found by a binary search first,
+// so a src that cannot beat the current kth element costs only O(log(topk)).
+template <typename Before>
+inline void
+merge_topk_inplace(int64_t topk,
+                   float* __restrict__ dst_values,
+                   int64_t* __restrict__ dst_labels,
+                   const float* __restrict__ src_values,
+                   const int64_t* __restrict__ src_labels,
+                   Before before) {
+    // largest m in [0, topk] such that src[m - 1] goes before dst[topk - m]
+    int64_t lo = 0;
+    int64_t hi = topk;
+    while (lo < hi) {
+        auto mid = (lo + hi + 1) / 2;
+        if (before(src_values[mid - 1], dst_values[topk - mid])) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    auto src_iter = lo;
+    auto dst_iter = topk - lo;
+    auto out = topk;
+    // merge from the tail, the write position never passes the unread part of dst
+    while (src_iter > 0) {
+        --out;
+        if (dst_iter > 0 && before(src_values[src_iter - 1], dst_values[dst_iter - 1])) {
+            --dst_iter;
+            dst_values[out] = dst_values[dst_iter];
+            dst_labels[out] = dst_labels[dst_iter];
+        } else {
+            --src_iter;
+            dst_values[out] = src_values[src_iter];
+            dst_labels[out] = src_labels[src_iter];
+        }
+    }
+}
+
 Status
 merge_into(int64_t num_queries,
            int64_t topk,
@@ -17,24 +17,35 @@ struct SearchResultPair {
     float distance_;
     milvus::SearchResult* search_result_;
     int64_t offset_;
+    int64_t offset_rb_;  // right bound of offset_
     int64_t index_;
 
-    SearchResultPair(float distance, milvus::SearchResult* search_result, int64_t offset, int64_t index)
-        : distance_(distance), search_result_(search_result), offset_(offset), index_(index) {
-    }
-
-    bool
-    operator<(const SearchResultPair& pair) const {
-        return std::isnan(pair.distance_) || (!std::isnan(distance_) && (distance_ < pair.distance_));
+    SearchResultPair(
+        float distance, milvus::SearchResult* search_result, int64_t offset, int64_t offset_rb, int64_t index)
+        : distance_(distance), search_result_(search_result), offset_(offset), offset_rb_(offset_rb), index_(index) {
     }
 
+    // larger distance goes first and nan goes last, ties are broken by segment index
     bool
     operator>(const SearchResultPair& pair) const {
-        return std::isnan(pair.distance_) || (!std::isnan(distance_) && (distance_ > pair.distance_));
+        if (std::isnan(distance_) || std::isnan(pair.distance_)) {
+            if (std::isnan(distance_) != std::isnan(pair.distance_)) {
+                return std::isnan(pair.distance_);
+            }
+        } else if (distance_ != pair.distance_) {
+            return distance_ > pair.distance_;
+        }
+        return index_ < pair.index_;
     }
 
-    void
-    reset_distance() {
+    // move to the next candidate of the same segment, return false when there is none
+    bool
+    advance() {
+        ++offset_;
+        if (offset_ >= offset_rb_) {
+            return false;
+        }
         distance_ = search_result_->result_distances_[offset_];
+        return true;
     }
 };
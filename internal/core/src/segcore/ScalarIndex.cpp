@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include "ScalarIndex.h"
+#include <algorithm>
 
 namespace milvus::segcore {
 std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
@@ -18,35 +19,60 @@ ScalarIndexVector::do_search_ids(const IdArray& ids) const {
     // TODO: support string array
     static_assert(std::is_same_v<T, int64_t>);
     Assert(ids.has_int_id());
-    auto src_ids = ids.int_id();
-    auto dst_ids = res_ids->mutable_int_id();
+    auto& src_ids = ids.int_id().data();
+
+    std::vector<int64_t> dst_ids;
     std::vector<SegOffset> dst_offsets;
+    search_ids_batch(src_ids.data(), src_ids.size(), nullptr, MAX_TIMESTAMP, dst_ids, dst_offsets);
+    res_ids->mutable_int_id()->mutable_data()->Add(dst_ids.begin(), dst_ids.end());
+    return {std::move(res_ids), std::move(dst_offsets)};
+}
 
-    // TODO: a possible optimization:
-    // TODO: sort the input id array to make access cache friendly
+void
+ScalarIndexVector::search_ids_batch(const int64_t* ids,
+                                    int64_t count,
+                                    const Timestamp* timestamps,
+                                    Timestamp timestamp,
+                                    std::vector<int64_t>& dst_ids,
+                                    std::vector<SegOffset>& dst_offsets) const {
+    std::vector<T> keys(ids, ids + count);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
 
-    // assume no repeated key now
-    // TODO: support repeated key
-    for (auto id : src_ids.data()) {
-        using Pair = std::pair<T, SegOffset>;
-        auto [iter_beg, iter_end] =
-            std::equal_range(mapping_.begin(), mapping_.end(), std::make_pair(id, SegOffset(0)),
-                             [](const Pair& left, const Pair& right) { return left.first < right.first; });
+    // merge join the sorted keys against mapping_, galloping over the entries in between
+    using Pair = std::pair<T, SegOffset>;
+    auto less = [](const Pair& entry, T key) { return entry.first < key; };
+    auto iter = mapping_.begin();
+    auto end = mapping_.end();
+    for (auto key : keys) {
+        int64_t step = 1;
+        auto bound = iter;
+        while (end - bound > step && (bound + step)->first < key) {
+            bound += step;
+            step *= 2;
+        }
+        iter = std::lower_bound(bound, end - bound > step ? bound + step + 1 : end, key, less);
+        if (iter == end) {
+            break;
+        }
 
-        if (iter_beg == iter_end) {
-            // no data
+        // mapping_ is sorted by (key, offset), the last visible version wins,
+        // a row is visible at its own timestamp like in the timestamp mask
+        SegOffset the_offset(-1);
+        for (; iter != end && iter->first == key; ++iter) {
+            auto offset = iter->second;
+            if (timestamps == nullptr || timestamps[offset.get()] <= timestamp) {
+                the_offset = offset;
+            }
+        }
+        if (the_offset == SegOffset(-1)) {
             continue;
         }
-        // TODO: for repeated key, decide the final offset with Timestamp
-        // no repeated key, simplified logic
-        Assert(iter_beg + 1 == iter_end);
-        auto [entry_id, entry_offset] = *iter_beg;
-
-        dst_ids->add_data(entry_id);
-        dst_offsets.push_back(entry_offset);
+        dst_ids.push_back(key);
+        dst_offsets.push_back(the_offset);
     }
-    return {std::move(res_ids), std::move(dst_offsets)};
 }
+
 void
 ScalarIndexVector::append_data(const ScalarIndexVector::T* ids, int64_t count, SegOffset base) {
     for (int64_t i = 0; i < count; ++i) {
@@ -25,6 +25,21 @@ class ScalarIndexBase {
  public:
     virtual std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
     do_search_ids(const IdArray& ids) const = 0;
+
+    // batched lookup of count ids, the result is ordered by id and free of duplicates
+    // for a repeated key, the largest offset whose timestamp is less than timestamp wins
+    // timestamps == nullptr means every offset is visible
+    virtual void
+    search_ids_batch(const int64_t* ids,
+                     int64_t count,
+                     const Timestamp* timestamps,
+                     Timestamp timestamp,
+                     std::vector<int64_t>& dst_ids,
+                     std::vector<SegOffset>& dst_offsets) const = 0;
+
+    virtual int64_t
+    memory_usage_in_bytes() const = 0;
+
     virtual ~ScalarIndexBase() = default;
     virtual std::string
     debug() const = 0;
@@ -44,6 +59,19 @@ class ScalarIndexVector : public ScalarIndexBase {
     std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
     do_search_ids(const IdArray& ids) const override;
 
+    void
+    search_ids_batch(const int64_t* ids,
+                     int64_t count,
+                     const Timestamp* timestamps,
+                     Timestamp timestamp,
+                     std::vector<int64_t>& dst_ids,
+                     std::vector<SegOffset>& dst_offsets) const override;
+
+    int64_t
+    memory_usage_in_bytes() const override {
+        return mapping_.capacity() * sizeof(mapping_[0]);
+    }
+
     std::string
     debug() const override {
         std::string dbg_str;
@@ -25,16 +25,21 @@ namespace milvus::segcore {
 struct SealedIndexingEntry {
     MetricType metric_type_;
     knowhere::VecIndexPtr indexing_;
+    int64_t memory_usage_ = 0;
 };
 
 using SealedIndexingEntryPtr = std::unique_ptr<SealedIndexingEntry>;
 
 struct SealedIndexingRecord {
     void
-    append_field_indexing(FieldOffset field_offset, MetricType metric_type, knowhere::VecIndexPtr indexing) {
+    append_field_indexing(FieldOffset field_offset,
+                          MetricType metric_type,
+                          knowhere::VecIndexPtr indexing,
+                          int64_t memory_usage) {
         auto ptr = std::make_unique<SealedIndexingEntry>();
         ptr->indexing_ = indexing;
         ptr->metric_type_ = metric_type;
+        ptr->memory_usage_ = memory_usage;
         std::unique_lock lck(mutex_);
         field_indexings_[field_offset] = std::move(ptr);
     }
@@ -58,6 +63,16 @@ struct SealedIndexingRecord {
         return field_indexings_.count(field_offset);
     }
 
+    int64_t
+    get_memory_usage_in_bytes() const {
+        std::shared_lock lck(mutex_);
+        int64_t total_bytes = 0;
+        for (auto& [field_offset, entry] : field_indexings_) {
+            total_bytes += entry->memory_usage_;
+        }
+        return total_bytes;
+    }
+
  private:
     // field_offset -> SealedIndexingEntry
     std::map<FieldOffset, SealedIndexingEntryPtr> field_indexings_;
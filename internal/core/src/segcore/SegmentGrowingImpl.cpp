@@ -25,6 +25,7 @@
 #include "segcore/SegmentGrowingImpl.h"
 #include "query/PlanNode.h"
 #include "query/PlanImpl.h"
+#include "query/ExprKernel.h"
 #include "segcore/Reduce.h"
 #include "utils/tools.h"
 #include <boost/iterator/counting_iterator.hpp>
@@ -50,71 +51,70 @@ SegmentGrowingImpl::get_deleted_bitmap(int64_t del_barrier,
                                        bool force) -> std::shared_ptr<DeletedRecord::TmpBitmap> {
     auto old = deleted_record_.get_lru_entry();
 
-    if (!force || old->bitmap_ptr->count() == insert_barrier) {
+    if (!force || old->insert_barrier == insert_barrier) {
         if (old->del_barrier == del_barrier) {
             return old;
         }
     }
 
+    // only the chunks touched by the deletes in between are copied
     auto current = old->clone(insert_barrier);
     current->del_barrier = del_barrier;
 
-    auto bitmap = current->bitmap_ptr;
+    // resolve the delete logs in between as one batch
+    auto [del_begin, del_end] = std::minmax(del_barrier, old->del_barrier);
+    std::vector<idx_t> del_uids(del_end - del_begin);
+    for (auto del_index = del_begin; del_index < del_end; ++del_index) {
+        del_uids[del_index - del_begin] = deleted_record_.uids_[del_index];
+    }
+    // the max offset of an uid is closest to query_timestamp, so the delete log should refer to it
+    std::vector<idx_t> uids;
+    std::vector<SegOffset> offsets;
+    search_uids_batch(del_uids.data(), del_uids.size(), query_timestamp, insert_barrier, uids, offsets);
+
     if (del_barrier < old->del_barrier) {
-        for (auto del_index = del_barrier; del_index < old->del_barrier; ++del_index) {
-            // get uid in delete logs
-            auto uid = deleted_record_.uids_[del_index];
-            // map uid to corresponding offsets, select the max one, which should be the target
-            // the max one should be closest to query_timestamp, so the delete log should refer to it
-            int64_t the_offset = -1;
-            auto [iter_b, iter_e] = uid2offset_.equal_range(uid);
-            for (auto iter = iter_b; iter != iter_e; ++iter) {
-                auto offset = iter->second;
-                if (record_.timestamps_[offset] < query_timestamp) {
-                    Assert(offset < insert_barrier);
-                    the_offset = std::max(the_offset, offset);
-                }
-            }
-            // if not found, skip
-            if (the_offset == -1) {
-                continue;
-            }
-            // otherwise, clear the flag
-            bitmap->clear(the_offset);
+        for (auto offset : offsets) {
+            current->clear(offset.get());
         }
         return current;
     } else {
-        for (auto del_index = old->del_barrier; del_index < del_barrier; ++del_index) {
-            // get uid in delete logs
-            auto uid = deleted_record_.uids_[del_index];
-            // map uid to corresponding offsets, select the max one, which should be the target
-            // the max one should be closest to query_timestamp, so the delete log should refer to it
-            int64_t the_offset = -1;
-            auto [iter_b, iter_e] = uid2offset_.equal_range(uid);
-            for (auto iter = iter_b; iter != iter_e; ++iter) {
-                auto offset = iter->second;
-                if (offset >= insert_barrier) {
-                    continue;
-                }
-                if (record_.timestamps_[offset] < query_timestamp) {
-                    Assert(offset < insert_barrier);
-                    the_offset = std::max(the_offset, offset);
-                }
-            }
-
-            // if not found, skip
-            if (the_offset == -1) {
-                continue;
-            }
-
-            // otherwise, set the flag
-            bitmap->set(the_offset);
+        for (auto offset : offsets) {
+            current->set(offset.get());
         }
         this->deleted_record_.insert_lru_entry(current);
     }
     return current;
 }
 
+void
+SegmentGrowingImpl::search_uids_batch(const idx_t* uids,
+                                      int64_t count,
+                                      Timestamp timestamp,
+                                      int64_t insert_barrier,
+                                      std::vector<idx_t>& dst_uids,
+                                      std::vector<SegOffset>& dst_offsets) const {
+    // each distinct uid is probed once, in order
+    std::vector<idx_t> keys(uids, uids + count);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<int64_t> the_offsets(keys.size(), -1);
+    uid2offset_.for_each_offset(keys.data(), keys.size(), [&](int64_t i, int64_t offset) {
+        // a row is visible at its own timestamp, like in get_active_count and the sealed timestamp mask
+        if (offset < insert_barrier && record_.timestamps_[offset] <= timestamp) {
+            the_offsets[i] = std::max(the_offsets[i], offset);
+        }
+    });
+    for (int64_t i = 0; i < keys.size(); ++i) {
+        // if not found, skip
+        if (the_offsets[i] == -1) {
+            continue;
+        }
+        dst_uids.push_back(keys[i]);
+        dst_offsets.emplace_back(the_offsets[i]);
+    }
+}
+
 Status
 SegmentGrowingImpl::Insert(int64_t reserved_begin,
                            int64_t size,
@@ -186,19 +186,14 @@ SegmentGrowingImpl::do_insert(int64_t reserved_begin,
     }
 
     if (schema_->get_is_auto_id()) {
-        for (int i = 0; i < size; ++i) {
-            auto row_id = row_ids[i];
-            // NOTE: this must be the last step, cannot be put above
-            uid2offset_.insert(std::make_pair(row_id, reserved_begin + i));
-        }
+        // NOTE: this must be the last step, cannot be put above
+        uid2offset_.insert(row_ids, size, reserved_begin);
     } else {
         auto offset = schema_->get_primary_key_offset().value_or(FieldOffset(-1));
         Assert(offset.get() != -1);
         auto& row = columns_data[offset.get()];
         auto row_ptr = reinterpret_cast<const int64_t*>(row.data());
-        for (int i = 0; i < size; ++i) {
-            uid2offset_.insert(std::make_pair(row_ptr[i], reserved_begin + i));
-        }
+        uid2offset_.insert(row_ptr, size, reserved_begin);
     }
 
     record_.ack_responder_.AddSegment(reserved_begin, reserved_begin + size);
@@ -240,15 +235,19 @@ SegmentGrowingImpl::Delete(int64_t reserved_begin,
     //    return Status::OK();
 }
 
-int64_t
-SegmentGrowingImpl::GetMemoryUsageInBytes() const {
-    int64_t total_bytes = 0;
-    auto size_per_chunk = segcore_config_.get_size_per_chunk();
-    int64_t ins_n = upper_align(record_.reserved, size_per_chunk);
-    total_bytes += ins_n * (schema_->get_total_sizeof() + 16 + 1);
-    int64_t del_n = upper_align(deleted_record_.reserved, size_per_chunk);
-    total_bytes += del_n * (16 * 2);
-    return total_bytes;
+MemoryUsage
+SegmentGrowingImpl::GetMemoryUsage() const {
+    MemoryUsage usage;
+    for (int i = 0; i < schema_->size(); ++i) {
+        usage.field_data += record_.get_field_data_base(FieldOffset(i))->memory_usage_in_bytes();
+    }
+    usage.system_field_data = record_.uids_.memory_usage_in_bytes() + record_.timestamps_.memory_usage_in_bytes();
+    usage.vector_index = indexing_record_.get_memory_usage_in_bytes(true) +
+                         sealed_indexing_record_.get_memory_usage_in_bytes();
+    usage.scalar_index = indexing_record_.get_memory_usage_in_bytes(false);
+    usage.primary_key_index = uid2offset_.memory_usage_in_bytes();
+    usage.delete_record = deleted_record_.memory_usage_in_bytes();
+    return usage;
 }
 
 SpanBase
@@ -438,49 +437,49 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
 }
 
 std::vector<SegOffset>
-SegmentGrowingImpl::search_ids(const boost::dynamic_bitset<>& bitset, Timestamp timestamp) const {
+SegmentGrowingImpl::search_ids(const boost::dynamic_bitset<>& bitset,
+                               Timestamp timestamp,
+                               int64_t skip,
+                               int64_t limit) const {
     std::vector<SegOffset> res_offsets;
-
-    for (int i = 0; i < bitset.size(); i++) {
-        if (bitset[i]) {
-            SegOffset the_offset(-1);
-            auto offset = SegOffset(i);
-            if (record_.timestamps_[offset.get()] < timestamp) {
-                the_offset = std::max(the_offset, offset);
+    if (limit <= 0) {
+        return res_offsets;
+    }
+    auto check_timestamp = timestamp != MAX_TIMESTAMP;
+    auto size_per_chunk = record_.timestamps_.get_size_per_chunk();
+    // timestamps are read from the chunk of the current bit, fetched once per chunk
+    int64_t chunk_id = -1;
+    const Timestamp* chunk_timestamps = nullptr;
+    query::ForEachSetBit(query::get_words(bitset), bitset.size(), [&](int64_t offset) {
+        if (check_timestamp) {
+            if (offset / size_per_chunk != chunk_id) {
+                chunk_id = offset / size_per_chunk;
+                chunk_timestamps = record_.timestamps_.get_span(chunk_id).data();
             }
-
-            if (the_offset == SegOffset(-1)) {
-                continue;
+            if (chunk_timestamps[offset % size_per_chunk] > timestamp) {
+                return true;
             }
-            res_offsets.push_back(the_offset);
         }
-    }
+        if (skip > 0) {
+            --skip;
+            return true;
+        }
+        res_offsets.emplace_back(offset);
+        return static_cast<int64_t>(res_offsets.size()) < limit;
+    });
     return res_offsets;
 }
 
 std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
 SegmentGrowingImpl::search_ids(const IdArray& id_array, Timestamp timestamp) const {
     Assert(id_array.has_int_id());
-    auto& src_int_arr = id_array.int_id();
-    auto res_id_arr = std::make_unique<IdArray>();
-    auto res_int_id_arr = res_id_arr->mutable_int_id();
+    auto& src_int_arr = id_array.int_id().data();
+    std::vector<idx_t> uids;
     std::vector<SegOffset> res_offsets;
-    for (auto uid : src_int_arr.data()) {
-        auto [iter_b, iter_e] = uid2offset_.equal_range(uid);
-        SegOffset the_offset(-1);
-        for (auto iter = iter_b; iter != iter_e; ++iter) {
-            auto offset = SegOffset(iter->second);
-            if (record_.timestamps_[offset.get()] < timestamp) {
-                the_offset = std::max(the_offset, offset);
-            }
-        }
-        // if not found, skip
-        if (the_offset == SegOffset(-1)) {
-            continue;
-        }
-        res_int_id_arr->add_data(uid);
-        res_offsets.push_back(the_offset);
-    }
+    search_uids_batch(src_int_arr.data(), src_int_arr.size(), timestamp, std::numeric_limits<int64_t>::max(), uids,
+                      res_offsets);
+    auto res_id_arr = std::make_unique<IdArray>();
+    res_id_arr->mutable_int_id()->mutable_data()->Add(uids.begin(), uids.end());
     return {std::move(res_id_arr), std::move(res_offsets)};
 }
 
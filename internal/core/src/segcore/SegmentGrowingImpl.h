@@ -12,7 +12,6 @@
 #pragma once
 
 #include <tbb/concurrent_priority_queue.h>
-#include <tbb/concurrent_unordered_map.h>
 #include <tbb/concurrent_vector.h>
 
 #include <shared_mutex>
@@ -29,6 +28,7 @@
 #include "exceptions/EasyAssert.h"
 #include "FieldIndexing.h"
 #include "InsertRecord.h"
+#include "PkHashIndex.h"
 #include <utility>
 #include <memory>
 #include <string>
@@ -63,8 +63,8 @@ class SegmentGrowingImpl : public SegmentGrowing {
     Status
     Delete(int64_t reserverd_offset, int64_t size, const int64_t* row_ids, const Timestamp* timestamps) override;
 
-    int64_t
-    GetMemoryUsageInBytes() const override;
+    MemoryUsage
+    GetMemoryUsage() const override;
 
     std::string
     debug() const override;
@@ -182,8 +182,18 @@ class SegmentGrowingImpl : public SegmentGrowing {
     std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
     search_ids(const IdArray& id_array, Timestamp timestamp) const override;
 
+    // latest offset of each distinct uid, visible before timestamp and below insert_barrier,
+    // the result is ordered by uid, serving both Retrieve and bulk deletes
+    void
+    search_uids_batch(const idx_t* uids,
+                      int64_t count,
+                      Timestamp timestamp,
+                      int64_t insert_barrier,
+                      std::vector<idx_t>& dst_uids,
+                      std::vector<SegOffset>& dst_offsets) const;
+
     std::vector<SegOffset>
-    search_ids(const boost::dynamic_bitset<>& view, Timestamp timestamp) const override;
+    search_ids(const boost::dynamic_bitset<>& view, Timestamp timestamp, int64_t skip, int64_t limit) const override;
 
  protected:
     int64_t
@@ -214,7 +224,7 @@ class SegmentGrowingImpl : public SegmentGrowing {
     IndexingRecord indexing_record_;
     SealedIndexingRecord sealed_indexing_record_;
 
-    tbb::concurrent_unordered_multimap<idx_t, int64_t> uid2offset_;
+    PkHashIndex uid2offset_;
 
  private:
     bool debug_disable_small_index_ = false;
@@ -11,6 +11,7 @@
 
 #include "segcore/SegmentInterface.h"
 #include "query/generated/ExecPlanNodeVisitor.h"
+#include <algorithm>
 namespace milvus::segcore {
 class Naive;
 
@@ -23,13 +24,31 @@ SegmentInternalInterface::FillTargetEntry(const query::Plan* plan, SearchResult&
     // Assert(results.result_offsets_.size() == size);
     Assert(results.row_data_.size() == 0);
 
-    // std::vector<int64_t> row_ids(size);
-    std::vector<int64_t> element_sizeofs;
-    std::vector<aligned_vector<char>> blobs;
+    // row_id/primary key goes first, then the target entries
+    std::vector<int64_t> element_sizeofs{sizeof(int64_t)};
+    for (auto field_offset : plan->target_entries_) {
+        element_sizeofs.push_back(get_schema()[field_offset].get_sizeof());
+    }
+    auto target_sizeof = std::accumulate(element_sizeofs.begin(), element_sizeofs.end(), int64_t(0));
+    auto max_sizeof = *std::max_element(element_sizeofs.begin(), element_sizeofs.end());
+    results.row_data_sizeof_ = target_sizeof;
+    results.row_data_.resize(size * target_sizeof);
+
+    // gather a column, then scatter it into its place of every row
+    aligned_vector<char> blob(size * max_sizeof);
+    int64_t element_offset = 0;
+    auto scatter = [&](const char* column, int64_t element_sizeof) {
+        auto dst = results.row_data_.data() + element_offset;
+        for (int64_t i = 0; i < size; ++i) {
+            memcpy(dst + i * target_sizeof, column + i * element_sizeof, element_sizeof);
+        }
+        element_offset += element_sizeof;
+    };
 
-    // fill row_ids
-    {
-        aligned_vector<char> blob(size * sizeof(int64_t));
+    // fill row_ids, which may be fetched already during reduce
+    if (results.primary_keys_.size() == size) {
+        scatter(reinterpret_cast<const char*>(results.primary_keys_.data()), sizeof(int64_t));
+    } else {
         if (plan->schema_.get_is_auto_id()) {
             bulk_subscript(SystemFieldType::RowId, results.internal_seg_offsets_.data(), size, blob.data());
         } else {
@@ -39,35 +58,33 @@ SegmentInternalInterface::FillTargetEntry(const query::Plan* plan, SearchResult&
             Assert(get_schema()[key_offset].get_data_type() == DataType::INT64);
             bulk_subscript(key_offset, results.internal_seg_offsets_.data(), size, blob.data());
         }
-        blobs.emplace_back(std::move(blob));
-        element_sizeofs.push_back(sizeof(int64_t));
+        scatter(blob.data(), sizeof(int64_t));
     }
 
     // fill other entries
-    for (auto field_offset : plan->target_entries_) {
-        auto& field_meta = get_schema()[field_offset];
-        auto element_sizeof = field_meta.get_sizeof();
-        aligned_vector<char> blob(size * element_sizeof);
+    for (int loc = 0; loc < plan->target_entries_.size(); ++loc) {
+        auto field_offset = plan->target_entries_[loc];
         bulk_subscript(field_offset, results.internal_seg_offsets_.data(), size, blob.data());
-        blobs.emplace_back(std::move(blob));
-        element_sizeofs.push_back(element_sizeof);
+        scatter(blob.data(), element_sizeofs[loc + 1]);
     }
+    assert(element_offset == target_sizeof);
+}
 
-    auto target_sizeof = std::accumulate(element_sizeofs.begin(), element_sizeofs.end(), 0);
-
-    for (int64_t i = 0; i < size; ++i) {
-        int64_t element_offset = 0;
-        std::vector<char> target(target_sizeof);
-        for (int loc = 0; loc < blobs.size(); ++loc) {
-            auto element_sizeof = element_sizeofs[loc];
-            auto blob_ptr = blobs[loc].data();
-            auto src = blob_ptr + element_sizeof * i;
-            auto dst = target.data() + element_offset;
-            memcpy(dst, src, element_sizeof);
-            element_offset += element_sizeof;
-        }
-        assert(element_offset == target_sizeof);
-        results.row_data_.emplace_back(std::move(target));
+void
+SegmentInternalInterface::FillPrimaryKeys(const query::Plan* plan, SearchResult& results) const {
+    std::shared_lock lck(mutex_);
+    AssertInfo(plan, "empty plan");
+    auto size = results.internal_seg_offsets_.size();
+    results.primary_keys_.resize(size);
+    if (plan->schema_.get_is_auto_id()) {
+        bulk_subscript(SystemFieldType::RowId, results.internal_seg_offsets_.data(), size,
+                       results.primary_keys_.data());
+    } else {
+        auto key_offset_opt = get_schema().get_primary_key_offset();
+        Assert(key_offset_opt.has_value());
+        auto key_offset = key_offset_opt.value();
+        Assert(get_schema()[key_offset].get_data_type() == DataType::INT64);
+        bulk_subscript(key_offset, results.internal_seg_offsets_.data(), size, results.primary_keys_.data());
     }
 }
 
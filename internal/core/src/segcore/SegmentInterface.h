@@ -15,6 +15,7 @@
 #include "query/Plan.h"
 #include "common/Span.h"
 #include "FieldIndexing.h"
+#include "MemoryUsage.h"
 #include <knowhere/index/vector_index/VecIndex.h>
 #include "common/SystemProperty.h"
 #include "query/PlanNode.h"
@@ -36,14 +37,24 @@ class SegmentInterface {
     virtual void
     FillTargetEntry(const query::Plan* plan, SearchResult& results) const = 0;
 
+    // fill results.primary_keys_ according to results.internal_seg_offsets_
+    virtual void
+    FillPrimaryKeys(const query::Plan* plan, SearchResult& results) const = 0;
+
     virtual SearchResult
     Search(const query::Plan* Plan, const query::PlaceholderGroup& placeholder_group, Timestamp timestamp) const = 0;
 
     virtual std::unique_ptr<proto::segcore::RetrieveResults>
     Retrieve(const query::RetrievePlan* Plan, Timestamp timestamp) const = 0;
 
-    virtual int64_t
-    GetMemoryUsageInBytes() const = 0;
+    // bytes held by the segment, by category
+    virtual MemoryUsage
+    GetMemoryUsage() const = 0;
+
+    int64_t
+    GetMemoryUsageInBytes() const {
+        return GetMemoryUsage().total();
+    }
 
     virtual int64_t
     get_row_count() const = 0;
@@ -77,6 +88,12 @@ class SegmentInternalInterface : public SegmentInterface {
         return *ptr;
     }
 
+    // a chunk below num_chunk_index may still lack its index if building it failed
+    bool
+    has_chunk_index(FieldOffset field_offset, int64_t chunk_id) const {
+        return chunk_index_impl(field_offset, chunk_id) != nullptr;
+    }
+
     SearchResult
     Search(const query::Plan* Plan,
            const query::PlaceholderGroup& placeholder_group,
@@ -85,6 +102,9 @@ class SegmentInternalInterface : public SegmentInterface {
     void
     FillTargetEntry(const query::Plan* plan, SearchResult& results) const override;
 
+    void
+    FillPrimaryKeys(const query::Plan* plan, SearchResult& results) const override;
+
     std::unique_ptr<proto::segcore::RetrieveResults>
     Retrieve(const query::RetrievePlan* plan, Timestamp timestamp) const override;
 
@@ -119,8 +139,9 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual int64_t
     get_active_count(Timestamp ts) const = 0;
 
+    // offsets of set bits visible at timestamp (written at or before it), skips the first skip hits and returns at most limit ones
     virtual std::vector<SegOffset>
-    search_ids(const boost::dynamic_bitset<>& view, Timestamp timestamp) const = 0;
+    search_ids(const boost::dynamic_bitset<>& view, Timestamp timestamp, int64_t skip, int64_t limit) const = 0;
 
  protected:
     // internal API: return chunk_data in span
@@ -15,6 +15,7 @@
 #include "pb/segcore.pb.h"
 #include "common/LoadInfo.h"
 #include <utility>
+#include <vector>
 
 namespace milvus::segcore {
 
@@ -26,6 +27,9 @@ class SegmentSealed : public SegmentInternalInterface {
     LoadSegmentMeta(const milvus::proto::segcore::LoadSegmentMeta& meta) = 0;
     virtual void
     LoadFieldData(const LoadFieldDataInfo& info) = 0;
+    // load several fields at once, indexes are built concurrently
+    virtual void
+    LoadSegment(const std::vector<LoadFieldDataInfo>& infos) = 0;
     virtual void
     DropIndex(const FieldId field_id) = 0;
     virtual void
@@ -13,6 +13,9 @@
 #include "query/SearchOnSealed.h"
 #include "query/ScalarIndex.h"
 #include "query/SearchBruteForce.h"
+#include "query/ExprKernel.h"
+#include <set>
+#include <tbb/parallel_for.h>
 
 namespace milvus::segcore {
 
@@ -36,6 +39,8 @@ SegmentSealedImpl::LoadIndex(const LoadIndexInfo& info) {
     auto metric_type_str = info.index_params.at("metric_type");
     auto row_count = info.index->Count();
     Assert(row_count > 0);
+    auto& field_meta = schema_->operator[](field_offset);
+    auto index_size = IndexMemoryUsage(*info.index, row_count * field_meta.get_sizeof());
 
     std::unique_lock lck(mutex_);
     Assert(!get_bit(vecindex_ready_bitset_, field_offset));
@@ -45,7 +50,7 @@ SegmentSealedImpl::LoadIndex(const LoadIndexInfo& info) {
         row_count_opt_ = row_count;
     }
     Assert(!vecindexs_.is_ready(field_offset));
-    vecindexs_.append_field_indexing(field_offset, GetMetricType(metric_type_str), info.index);
+    vecindexs_.append_field_indexing(field_offset, GetMetricType(metric_type_str), info.index, index_size);
 
     set_bit(vecindex_ready_bitset_, field_offset, true);
     lck.unlock();
@@ -54,7 +59,37 @@ SegmentSealedImpl::LoadIndex(const LoadIndexInfo& info) {
 void
 SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
     // NOTE: lock only when data is ready to avoid starvation
-    Assert(info.row_count > 0);
+    auto field = prepare_field_data(info);
+
+    std::unique_lock lck(mutex_);
+    check_field_data(field);
+    publish_field_data(std::move(field));
+}
+
+void
+SegmentSealedImpl::LoadSegment(const std::vector<LoadFieldDataInfo>& infos) {
+    std::set<int64_t> field_ids;
+    for (auto& info : infos) {
+        AssertInfo(field_ids.insert(info.field_id).second, "duplicated field in load segment");
+    }
+
+    // build columns and indexes of all fields concurrently, out of lock
+    std::vector<LoadedField> fields(infos.size());
+    tbb::parallel_for(size_t(0), infos.size(), [&](size_t i) { fields[i] = prepare_field_data(infos[i]); });
+
+    // publish all fields at once, or none of them
+    std::unique_lock lck(mutex_);
+    for (auto& field : fields) {
+        AssertInfo(field.row_count == fields[0].row_count, "load data has different row count from other columns");
+        check_field_data(field);
+    }
+    for (auto& field : fields) {
+        publish_field_data(std::move(field));
+    }
+}
+
+SegmentSealedImpl::LoadedField
+SegmentSealedImpl::prepare_field_data(const LoadFieldDataInfo& info) const {
     auto field_id = FieldId(info.field_id);
     Assert(info.blob);
     Assert(info.row_count > 0);
@@ -65,95 +100,105 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
         pk_index->build();
         return pk_index;
     };
+    // take over the blob if the loader allows, otherwise keep a copy
+    auto make_column = [&](int64_t length_in_bytes) {
+        if (info.release) {
+            return ColumnData::View(info.blob, length_in_bytes, info.release);
+        }
+        return ColumnData::Copy(info.blob, length_in_bytes);
+    };
 
+    LoadedField field;
+    field.field_id = field_id;
+    field.row_count = info.row_count;
     if (SystemProperty::Instance().IsSystem(field_id)) {
         auto system_field_type = SystemProperty::Instance().GetSystemFieldType(field_id);
         if (system_field_type == SystemFieldType::Timestamp) {
-            auto src_ptr = reinterpret_cast<const Timestamp*>(info.blob);
-            aligned_vector<Timestamp> vec_data(info.row_count);
-            std::copy_n(src_ptr, info.row_count, vec_data.data());
-
+            field.column = make_column(sizeof(Timestamp) * info.row_count);
+            auto src_ptr = field.column.get<Timestamp>();
             auto size = info.row_count;
 
             // TODO: load from outside
-            TimestampIndex index;
             auto min_slice_length = size < 4096 ? 1 : 4096;
             auto meta = GenerateFakeSlices(src_ptr, size, min_slice_length);
-            index.set_length_meta(std::move(meta));
-            index.build_with(src_ptr, size);
-
-            // use special index
-            std::unique_lock lck(mutex_);
-            update_row_count(info.row_count);
-            AssertInfo(timestamps_.empty(), "already exists");
-            timestamps_ = std::move(vec_data);
-            timestamp_index_ = std::move(index);
-
+            field.timestamp_index.set_length_meta(std::move(meta));
+            field.timestamp_index.build_with(src_ptr, size);
         } else {
             Assert(system_field_type == SystemFieldType::RowId);
-            auto src_ptr = reinterpret_cast<const idx_t*>(info.blob);
-
-            // prepare data
-            aligned_vector<idx_t> vec_data(info.row_count);
-            std::copy_n(src_ptr, info.row_count, vec_data.data());
+            field.column = make_column(sizeof(idx_t) * info.row_count);
 
-            std::unique_ptr<ScalarIndexBase> pk_index_;
             // fix unintentional index update
             if (schema_->get_is_auto_id()) {
-                pk_index_ = create_index(vec_data.data(), vec_data.size());
-            }
-
-            // write data under lock
-            std::unique_lock lck(mutex_);
-            update_row_count(info.row_count);
-            AssertInfo(row_ids_.empty(), "already exists");
-            row_ids_ = std::move(vec_data);
-
-            if (schema_->get_is_auto_id()) {
-                primary_key_index_ = std::move(pk_index_);
+                field.pk_index = create_index(field.column.get<idx_t>(), info.row_count);
             }
         }
-        ++system_ready_count_;
     } else {
-        // prepare data
         auto field_offset = schema_->get_offset(field_id);
         auto& field_meta = schema_->operator[](field_offset);
-        // Assert(!field_meta.is_vector());
         auto element_sizeof = field_meta.get_sizeof();
-        auto span = SpanBase(info.blob, info.row_count, element_sizeof);
-        auto length_in_bytes = element_sizeof * info.row_count;
-        aligned_vector<char> vec_data(length_in_bytes);
-        memcpy(vec_data.data(), info.blob, length_in_bytes);
+        field.column = make_column(element_sizeof * info.row_count);
+        auto span = SpanBase(field.column.data(), info.row_count, element_sizeof);
 
         // generate scalar index
-        std::unique_ptr<knowhere::Index> index;
         if (!field_meta.is_vector()) {
-            index = query::generate_scalar_index(span, field_meta.get_data_type());
+            field.scalar_index = query::generate_scalar_index(span, field_meta.get_data_type());
         }
 
-        std::unique_ptr<ScalarIndexBase> pk_index_;
         if (schema_->get_primary_key_offset() == field_offset) {
-            pk_index_ = create_index((const int64_t*)vec_data.data(), info.row_count);
+            field.pk_index = create_index(field.column.get<int64_t>(), info.row_count);
         }
+    }
+    return field;
+}
 
-        // write data under lock
-        std::unique_lock lck(mutex_);
-        update_row_count(info.row_count);
+void
+SegmentSealedImpl::check_field_data(const LoadedField& field) const {
+    if (row_count_opt_.has_value()) {
+        AssertInfo(row_count_opt_.value() == field.row_count, "load data has different row count from other columns");
+    }
+    if (SystemProperty::Instance().IsSystem(field.field_id)) {
+        auto system_field_type = SystemProperty::Instance().GetSystemFieldType(field.field_id);
+        if (system_field_type == SystemFieldType::Timestamp) {
+            AssertInfo(timestamps_.empty(), "already exists");
+        } else {
+            AssertInfo(row_ids_.empty(), "already exists");
+        }
+    } else {
+        auto field_offset = schema_->get_offset(field.field_id);
+        auto& field_meta = schema_->operator[](field_offset);
         AssertInfo(field_datas_[field_offset.get()].empty(), "field data already exists");
-
         if (field_meta.is_vector()) {
             AssertInfo(!vecindexs_.is_ready(field_offset), "field data can't be loaded when indexing exists");
-            field_datas_[field_offset.get()] = std::move(vec_data);
         } else {
             AssertInfo(!scalar_indexings_[field_offset.get()], "scalar indexing not cleared");
-            field_datas_[field_offset.get()] = std::move(vec_data);
-            scalar_indexings_[field_offset.get()] = std::move(index);
         }
+    }
+}
 
+void
+SegmentSealedImpl::publish_field_data(LoadedField&& field) {
+    update_row_count(field.row_count);
+    if (SystemProperty::Instance().IsSystem(field.field_id)) {
+        auto system_field_type = SystemProperty::Instance().GetSystemFieldType(field.field_id);
+        if (system_field_type == SystemFieldType::Timestamp) {
+            // use special index
+            timestamps_ = std::move(field.column);
+            timestamp_index_ = std::move(field.timestamp_index);
+            clear_timestamp_masks();
+        } else {
+            row_ids_ = std::move(field.column);
+            if (schema_->get_is_auto_id()) {
+                primary_key_index_ = std::move(field.pk_index);
+            }
+        }
+        ++system_ready_count_;
+    } else {
+        auto field_offset = schema_->get_offset(field.field_id);
+        field_datas_[field_offset.get()] = std::move(field.column);
+        scalar_indexings_[field_offset.get()] = std::move(field.scalar_index);
         if (schema_->get_primary_key_offset() == field_offset) {
-            primary_key_index_ = std::move(pk_index_);
+            primary_key_index_ = std::move(field.pk_index);
         }
-
         set_bit(field_data_ready_bitset_, field_offset, true);
     }
 }
@@ -192,12 +237,31 @@ SegmentSealedImpl::chunk_index_impl(FieldOffset field_offset, int64_t chunk_id)
     return ptr;
 }
 
-int64_t
-SegmentSealedImpl::GetMemoryUsageInBytes() const {
-    // TODO: add estimate for index
+MemoryUsage
+SegmentSealedImpl::GetMemoryUsage() const {
+    MemoryUsage usage;
     std::shared_lock lck(mutex_);
-    auto row_count = row_count_opt_.value_or(0);
-    return schema_->get_total_sizeof() * row_count;
+    for (auto& column : field_datas_) {
+        usage.field_data += column.size();
+    }
+    usage.system_field_data = row_ids_.size() + timestamps_.size();
+    usage.vector_index = vecindexs_.get_memory_usage_in_bytes();
+    for (auto& indexing : scalar_indexings_) {
+        if (indexing != nullptr) {
+            usage.scalar_index += indexing->Size();
+        }
+    }
+    if (primary_key_index_ != nullptr) {
+        usage.primary_key_index = primary_key_index_->memory_usage_in_bytes();
+    }
+    usage.timestamp_index = timestamp_index_.memory_usage_in_bytes();
+    lck.unlock();
+
+    std::lock_guard mask_lck(timestamp_mask_mutex_);
+    for (auto& [timestamp, mask] : timestamp_masks_) {
+        usage.cache += mask->num_blocks() * sizeof(boost::dynamic_bitset<>::block_type);
+    }
+    return usage;
 }
 
 int64_t
@@ -267,12 +331,15 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
     if (SystemProperty::Instance().IsSystem(field_id)) {
         auto system_field_type = SystemProperty::Instance().GetSystemFieldType(field_id);
 
+        // release (or unmap) the data out of lock
+        ColumnData column;
         std::unique_lock lck(mutex_);
         --system_ready_count_;
         if (system_field_type == SystemFieldType::RowId) {
-            auto row_ids = std::move(row_ids_);
+            column = std::move(row_ids_);
         } else if (system_field_type == SystemFieldType::Timestamp) {
-            auto ts = std::move(timestamps_);
+            column = std::move(timestamps_);
+            clear_timestamp_masks();
         }
         lck.unlock();
     } else {
@@ -281,10 +348,8 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
 
         std::unique_lock lck(mutex_);
         set_bit(field_data_ready_bitset_, field_offset, false);
-        auto vec = std::move(field_datas_[field_offset.get()]);
+        auto column = std::move(field_datas_[field_offset.get()]);
         lck.unlock();
-
-        vec.clear();
     }
 }
 
@@ -335,7 +400,7 @@ SegmentSealedImpl::bulk_subscript(SystemFieldType system_type,
                                   void* output) const {
     Assert(is_system_field_ready());
     Assert(system_type == SystemFieldType::RowId);
-    bulk_subscript_impl<int64_t>(row_ids_.data(), seg_offsets, count, output);
+    bulk_subscript_impl<int64_t>(row_ids_.get<idx_t>(), seg_offsets, count, output);
 }
 template <typename T>
 void
@@ -444,20 +509,41 @@ SegmentSealedImpl::HasFieldData(FieldId field_id) const {
 std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
 SegmentSealedImpl::search_ids(const IdArray& id_array, Timestamp timestamp) const {
     AssertInfo(id_array.has_int_id(), "string ids are not implemented");
-    auto arr = id_array.int_id();
+    auto& src_ids = id_array.int_id().data();
     Assert(primary_key_index_);
-    return primary_key_index_->do_search_ids(id_array);
+    auto timestamps = timestamps_.empty() ? nullptr : timestamps_.get<Timestamp>();
+    std::vector<int64_t> dst_ids;
+    std::vector<SegOffset> dst_offsets;
+    primary_key_index_->search_ids_batch(src_ids.data(), src_ids.size(), timestamps, timestamp, dst_ids,
+                                         dst_offsets);
+    auto res_id_arr = std::make_unique<IdArray>();
+    res_id_arr->mutable_int_id()->mutable_data()->Add(dst_ids.begin(), dst_ids.end());
+    return {std::move(res_id_arr), std::move(dst_offsets)};
 }
 
 std::vector<SegOffset>
-SegmentSealedImpl::search_ids(const boost::dynamic_bitset<>& bitset, Timestamp timestamp) const {
+SegmentSealedImpl::search_ids(const boost::dynamic_bitset<>& bitset,
+                              Timestamp timestamp,
+                              int64_t skip,
+                              int64_t limit) const {
     std::vector<SegOffset> dst_offset;
-    for (int i = 0; i < bitset.size(); i++) {
-        if (bitset[i]) {
-            dst_offset.emplace_back(SegOffset(i));
-        }
+    if (limit <= 0) {
+        return dst_offset;
     }
-    return std::move(dst_offset);
+    auto timestamps = timestamp != MAX_TIMESTAMP ? timestamps_.get<Timestamp>() : nullptr;
+    query::ForEachSetBit(query::get_words(bitset), bitset.size(), [&](int64_t offset) {
+        // a row is visible at its own timestamp, like in the primary key lookup and the timestamp mask
+        if (timestamps && timestamps[offset] > timestamp) {
+            return true;
+        }
+        if (skip > 0) {
+            --skip;
+            return true;
+        }
+        dst_offset.emplace_back(offset);
+        return static_cast<int64_t>(dst_offset.size()) < limit;
+    });
+    return dst_offset;
 }
 
 std::string
@@ -486,15 +572,48 @@ SegmentSealedImpl::get_active_count(Timestamp ts) const {
 }
 void
 SegmentSealedImpl::mask_with_timestamps(boost::dynamic_bitset<>& bitset_chunk, Timestamp timestamp) const {
-    // TODO change the
-    Assert(this->timestamps_.size() == get_row_count());
+    auto size = this->timestamps_.size() / int64_t(sizeof(Timestamp));
+    Assert(size == get_row_count());
     auto range = timestamp_index_.get_active_range(timestamp);
-    if (range.first == range.second && range.first == this->timestamps_.size()) {
+    if (range.first == range.second && range.first == size) {
         // just skip
         return;
     }
-    auto mask = TimestampIndex::GenerateBitset(timestamp, range, this->timestamps_.data(), this->timestamps_.size());
-    bitset_chunk &= mask;
+    auto mask = get_timestamp_mask(timestamp, range, size);
+    if (bitset_chunk.empty()) {
+        // no predicate, every visible row passes
+        bitset_chunk = *mask;
+    } else {
+        bitset_chunk &= *mask;
+    }
+}
+
+std::shared_ptr<const boost::dynamic_bitset<>>
+SegmentSealedImpl::get_timestamp_mask(Timestamp timestamp,
+                                      std::pair<int64_t, int64_t> active_range,
+                                      int64_t size) const {
+    // the active range is derived from the timestamp, so the timestamp alone is the key
+    {
+        std::lock_guard lck(timestamp_mask_mutex_);
+        for (auto iter = timestamp_masks_.begin(); iter != timestamp_masks_.end(); ++iter) {
+            if (iter->first == timestamp) {
+                auto mask = iter->second;
+                timestamp_masks_.erase(iter);
+                timestamp_masks_.emplace_front(timestamp, mask);
+                return mask;
+            }
+        }
+    }
+
+    auto mask = std::make_shared<const boost::dynamic_bitset<>>(
+        TimestampIndex::GenerateBitset(timestamp, active_range, this->timestamps_.get<Timestamp>(), size));
+
+    std::lock_guard lck(timestamp_mask_mutex_);
+    timestamp_masks_.emplace_front(timestamp, mask);
+    if (timestamp_masks_.size() > kTimestampMaskCacheSize) {
+        timestamp_masks_.pop_back();
+    }
+    return mask;
 }
 
 SegmentSealedPtr
@@ -14,10 +14,12 @@
 #include "segcore/SegmentSealed.h"
 #include "SealedIndexingRecord.h"
 #include "ScalarIndex.h"
+#include "ColumnData.h"
 #include <deque>
 #include <map>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <string>
 
@@ -30,6 +32,8 @@ class SegmentSealedImpl : public SegmentSealed {
     void
     LoadFieldData(const LoadFieldDataInfo& info) override;
     void
+    LoadSegment(const std::vector<LoadFieldDataInfo>& infos) override;
+    void
     LoadSegmentMeta(const milvus::proto::segcore::LoadSegmentMeta& segment_meta) override;
     void
     DropIndex(const FieldId field_id) override;
@@ -41,8 +45,8 @@ class SegmentSealedImpl : public SegmentSealed {
     HasFieldData(FieldId field_id) const override;
 
  public:
-    int64_t
-    GetMemoryUsageInBytes() const override;
+    MemoryUsage
+    GetMemoryUsage() const override;
 
     int64_t
     get_row_count() const override;
@@ -89,6 +93,26 @@ class SegmentSealedImpl : public SegmentSealed {
     get_active_count(Timestamp ts) const override;
 
  private:
+    // column and indexes of a field, built before taking the lock
+    struct LoadedField {
+        FieldId field_id;
+        int64_t row_count = 0;
+        ColumnData column;
+        std::unique_ptr<knowhere::Index> scalar_index;
+        std::unique_ptr<ScalarIndexBase> pk_index;
+        TimestampIndex timestamp_index;
+    };
+
+    LoadedField
+    prepare_field_data(const LoadFieldDataInfo& info) const;
+
+    // both need mutex_ held, check all fields before publishing any of them
+    void
+    check_field_data(const LoadedField& field) const;
+
+    void
+    publish_field_data(LoadedField&& field);
+
     template <typename T>
     static void
     bulk_subscript_impl(const void* src_raw, const int64_t* seg_offsets, int64_t count, void* dst_raw);
@@ -109,6 +133,16 @@ class SegmentSealedImpl : public SegmentSealed {
     void
     mask_with_timestamps(boost::dynamic_bitset<>& bitset_chunk, Timestamp timestamp) const override;
 
+    // visibility mask of timestamp, recently used masks are cached
+    std::shared_ptr<const boost::dynamic_bitset<>>
+    get_timestamp_mask(Timestamp timestamp, std::pair<int64_t, int64_t> active_range, int64_t size) const;
+
+    void
+    clear_timestamp_masks() {
+        std::lock_guard lck(timestamp_mask_mutex_);
+        timestamp_masks_.clear();
+    }
+
     void
     vector_search(int64_t vec_count,
                   query::SearchInfo search_info,
@@ -127,7 +161,7 @@ class SegmentSealedImpl : public SegmentSealed {
     search_ids(const IdArray& id_array, Timestamp timestamp) const override;
 
     std::vector<SegOffset>
-    search_ids(const boost::dynamic_bitset<>& view, Timestamp timestamp) const override;
+    search_ids(const boost::dynamic_bitset<>& view, Timestamp timestamp, int64_t skip, int64_t limit) const override;
 
     //    virtual void
     //    build_index_if_primary_key(FieldId field_id);
@@ -147,12 +181,17 @@ class SegmentSealedImpl : public SegmentSealed {
     std::vector<std::unique_ptr<knowhere::Index>> scalar_indexings_;
     std::unique_ptr<ScalarIndexBase> primary_key_index_;
 
-    std::vector<aligned_vector<char>> field_datas_;
+    std::vector<ColumnData> field_datas_;
 
     SealedIndexingRecord vecindexs_;
-    aligned_vector<idx_t> row_ids_;
-    aligned_vector<Timestamp> timestamps_;
+    ColumnData row_ids_;
+    ColumnData timestamps_;
     TimestampIndex timestamp_index_;
+
+    // most recent first, cleared whenever timestamps_ changes
+    static constexpr int kTimestampMaskCacheSize = 8;
+    mutable std::mutex timestamp_mask_mutex_;
+    mutable std::deque<std::pair<Timestamp, std::shared_ptr<const boost::dynamic_bitset<>>>> timestamp_masks_;
     SchemaPtr schema_;
 };
 }  // namespace milvus::segcore
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <segcore/TimestampIndex.h>
+#include "query/ExprKernel.h"
 
 namespace milvus::segcore {
 void
@@ -65,14 +66,23 @@ TimestampIndex::GenerateBitset(Timestamp query_timestamp,
                                const Timestamp* timestamps,
                                int64_t size) {
     auto [beg, end] = active_range;
-    Assert(beg < end);
+    Assert(beg <= end && end <= size);
     boost::dynamic_bitset<> bitset;
     bitset.reserve(size);
     bitset.resize(beg, true);
     bitset.resize(size, false);
-    for (int64_t i = beg; i < end; ++i) {
-        bitset[i] = timestamps[i] <= query_timestamp;
+    if (beg == end) {
+        return bitset;
     }
+    // rows before beg are visible, so fill from the word containing beg on
+    using query::BITS_PER_WORD;
+    auto first_word = beg / BITS_PER_WORD;
+    auto base = first_word * BITS_PER_WORD;
+    auto words = query::get_words(bitset) + first_word;
+    auto src = timestamps + base;
+    auto local_beg = beg - base;
+    query::FillWords(
+        end - base, [=](int64_t i) -> bool { return (i < local_beg) | (src[i] <= query_timestamp); }, words);
     return bitset;
 }
 
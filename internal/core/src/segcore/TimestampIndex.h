@@ -37,6 +37,12 @@ class TimestampIndex {
                    const Timestamp* timestamps,
                    int64_t size);
 
+    int64_t
+    memory_usage_in_bytes() const {
+        return (lengths_.capacity() + start_locs_.capacity()) * sizeof(int64_t) +
+               timestamp_barriers_.capacity() * sizeof(Timestamp);
+    }
+
  private:
     // numSlice
     std::vector<int64_t> lengths_;
@@ -136,8 +136,33 @@ AppendBinaryIndex(CBinarySet c_binary_set, void* index_binary, int64_t index_siz
         auto binary_set = (milvus::knowhere::BinarySet*)c_binary_set;
         std::string index_key(c_index_key);
         uint8_t* index = (uint8_t*)index_binary;
-        std::shared_ptr<uint8_t[]> data(index, [](void*) {});
+        auto binary = std::make_shared<milvus::knowhere::Binary>();
+        binary->data = std::shared_ptr<uint8_t[]>(index, [](void*) {});
+        binary->size = index_size;
+        // the memory stays owned by the caller
+        binary->owned = false;
+        binary_set->Append(index_key, binary);
+
+        auto status = CStatus();
+        status.error_code = Success;
+        status.error_msg = "";
+        return status;
+    } catch (std::exception& e) {
+        auto status = CStatus();
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+        return status;
+    }
+}
+
+CStatus
+AllocateBinaryIndex(CBinarySet c_binary_set, const char* c_index_key, int64_t index_size, void** index_binary) {
+    try {
+        auto binary_set = (milvus::knowhere::BinarySet*)c_binary_set;
+        std::string index_key(c_index_key);
+        std::shared_ptr<uint8_t[]> data(new uint8_t[index_size]);
         binary_set->Append(index_key, data, index_size);
+        *index_binary = data.get();
 
         auto status = CStatus();
         status.error_code = Success;
@@ -47,6 +47,11 @@ DeleteBinarySet(CBinarySet c_binary_set);
 CStatus
 AppendBinaryIndex(CBinarySet c_binary_set, void* index_binary, int64_t index_size, const char* c_index_key);
 
+// allocate index_size bytes owned by the binary set under c_index_key, the caller fills them in place,
+// e.g. reading every slice of a sliced key at its offset so that loading does not assemble it again
+CStatus
+AllocateBinaryIndex(CBinarySet c_binary_set, const char* c_index_key, int64_t index_size, void** index_binary);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,9 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <vector>
+#include <unordered_set>
+#include <algorithm>
+#include <tbb/parallel_for.h>
 #include <exceptions/EasyAssert.h>
 
 #include "query/Plan.h"
@@ -52,57 +55,106 @@ DeleteMarshaledHits(CMarshaledHits c_marshaled_hits) {
     delete hits;
 }
 
+// merge the topk candidates of every segment for one query with a heap, which writes
+// the segment index and the offset of each result into slot_segments and slot_offsets.
+// an entity found by more than one segment only takes the slot of its best candidate.
 void
-GetResultData(std::vector<std::vector<int64_t>>& search_records,
-              std::vector<SearchResult*>& search_results,
+GetResultData(std::vector<SearchResult*>& search_results,
               int64_t query_idx,
-              int64_t topk) {
+              int64_t topk,
+              int64_t* slot_segments,
+              int64_t* slot_offsets) {
     auto num_segments = search_results.size();
     AssertInfo(num_segments > 0, "num segment must greater than 0");
-    std::vector<SearchResultPair> result_pairs;
+    AssertInfo(topk > 0, "topk must greater than 0");
     int64_t query_offset = query_idx * topk;
+    std::vector<SearchResultPair> heap;
+    heap.reserve(num_segments);
     for (int j = 0; j < num_segments; ++j) {
         auto search_result = search_results[j];
         AssertInfo(search_result != nullptr, "search result must not equal to nullptr");
         auto distance = search_result->result_distances_[query_offset];
-        result_pairs.push_back(SearchResultPair(distance, search_result, query_offset, j));
+        heap.emplace_back(distance, search_result, query_offset, query_offset + topk, j);
     }
-    int64_t loc_offset = query_offset;
-    AssertInfo(topk > 0, "topk must greater than 0");
-    for (int i = 0; i < topk; ++i) {
-        result_pairs[0].reset_distance();
-        std::sort(result_pairs.begin(), result_pairs.end(), std::greater<>());
-        auto& result_pair = result_pairs[0];
-        auto index = result_pair.index_;
-        result_pair.search_result_->result_offsets_.push_back(loc_offset++);
-        search_records[index].push_back(result_pair.offset_++);
+    auto worse = [](const SearchResultPair& left, const SearchResultPair& right) { return right > left; };
+    std::make_heap(heap.begin(), heap.end(), worse);
+
+    std::unordered_set<int64_t> primary_keys;
+    std::vector<std::pair<int64_t, int64_t>> duplicates;
+    int64_t filled = 0;
+    while (filled < topk && !heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), worse);
+        auto& pair = heap.back();
+        auto search_result = pair.search_result_;
+        auto offset = pair.offset_;
+        auto is_valid = search_result->internal_seg_offsets_[offset] != -1;
+        if (is_valid && !primary_keys.insert(search_result->primary_keys_[offset]).second) {
+            duplicates.emplace_back(pair.index_, offset);
+        } else {
+            slot_segments[filled] = pair.index_;
+            slot_offsets[filled] = offset;
+            ++filled;
+        }
+        if (pair.advance()) {
+            std::push_heap(heap.begin(), heap.end(), worse);
+        } else {
+            heap.pop_back();
+        }
     }
+
+    // too few distinct entities to fill topk, keep the best duplicates
+    for (auto& [segment_index, offset] : duplicates) {
+        if (filled == topk) {
+            break;
+        }
+        slot_segments[filled] = segment_index;
+        slot_offsets[filled] = offset;
+        ++filled;
+    }
+    AssertInfo(filled == topk, "the reduced result's size less than topk");
 }
 
+// keep only the candidates chosen by GetResultData in every search result, in slot order
 void
-ResetSearchResult(std::vector<std::vector<int64_t>>& search_records, std::vector<SearchResult*>& search_results) {
+ResetSearchResult(std::vector<SearchResult*>& search_results,
+                  const std::vector<int64_t>& slot_segments,
+                  const std::vector<int64_t>& slot_offsets) {
     auto num_segments = search_results.size();
     AssertInfo(num_segments > 0, "num segment must greater than 0");
+    std::vector<int64_t> counts(num_segments, 0);
+    for (auto segment_index : slot_segments) {
+        ++counts[segment_index];
+    }
+
+    std::vector<std::vector<float>> result_distances(num_segments);
+    std::vector<std::vector<int64_t>> internal_seg_offsets(num_segments);
+    std::vector<std::vector<int64_t>> primary_keys(num_segments);
     for (int i = 0; i < num_segments; i++) {
         auto search_result = search_results[i];
         AssertInfo(search_result != nullptr, "search result must not equal to nullptr");
-        if (search_result->result_offsets_.size() == 0) {
-            continue;
-        }
-
-        std::vector<float> result_distances;
-        std::vector<int64_t> internal_seg_offsets;
+        result_distances[i].resize(counts[i]);
+        internal_seg_offsets[i].resize(counts[i]);
+        primary_keys[i].resize(counts[i]);
+        search_result->result_offsets_.resize(counts[i]);
+    }
 
-        for (int j = 0; j < search_records[i].size(); j++) {
-            auto& offset = search_records[i][j];
-            auto distance = search_result->result_distances_[offset];
-            auto internal_seg_offset = search_result->internal_seg_offsets_[offset];
-            result_distances.push_back(distance);
-            internal_seg_offsets.push_back(internal_seg_offset);
-        }
+    std::vector<int64_t> positions(num_segments, 0);
+    for (int64_t loc = 0; loc < slot_segments.size(); ++loc) {
+        auto segment_index = slot_segments[loc];
+        auto offset = slot_offsets[loc];
+        auto search_result = search_results[segment_index];
+        auto pos = positions[segment_index]++;
+        result_distances[segment_index][pos] = search_result->result_distances_[offset];
+        internal_seg_offsets[segment_index][pos] = search_result->internal_seg_offsets_[offset];
+        primary_keys[segment_index][pos] = search_result->primary_keys_[offset];
+        search_result->result_offsets_[pos] = loc;
+    }
 
-        search_result->result_distances_ = result_distances;
-        search_result->internal_seg_offsets_ = internal_seg_offsets;
+    for (int i = 0; i < num_segments; i++) {
+        auto search_result = search_results[i];
+        search_result->result_distances_ = std::move(result_distances[i]);
+        search_result->internal_seg_offsets_ = std::move(internal_seg_offsets[i]);
+        search_result->primary_keys_ = std::move(primary_keys[i]);
     }
 }
 
@@ -116,12 +168,20 @@ ReduceSearchResultsAndFillData(CSearchPlan c_plan, CSearchResult* c_search_resul
         }
         auto topk = search_results[0]->topk_;
         auto num_queries = search_results[0]->num_queries_;
-        std::vector<std::vector<int64_t>> search_records(num_segments);
 
-        for (int i = 0; i < num_queries; ++i) {
-            GetResultData(search_records, search_results, i, topk);
+        for (int i = 0; i < num_segments; ++i) {
+            auto search_result = search_results[i];
+            AssertInfo(search_result != nullptr, "search result must not equal to nullptr");
+            auto segment = (milvus::segcore::SegmentInterface*)(search_result->segment_);
+            segment->FillPrimaryKeys(plan, *search_result);
         }
-        ResetSearchResult(search_records, search_results);
+
+        std::vector<int64_t> slot_segments(num_queries * topk);
+        std::vector<int64_t> slot_offsets(num_queries * topk);
+        tbb::parallel_for(int64_t(0), num_queries, [&](int64_t i) {
+            GetResultData(search_results, i, topk, slot_segments.data() + i * topk, slot_offsets.data() + i * topk);
+        });
+        ResetSearchResult(search_results, slot_segments, slot_offsets);
 
         for (int i = 0; i < num_segments; ++i) {
             auto search_result = search_results[i];
@@ -150,7 +210,8 @@ ReorganizeSearchResults(CMarshaledHits* c_marshaled_hits, CSearchResult* c_searc
         auto num_queries = sr->num_queries_;
 
         std::vector<float> result_distances(num_queries * topk);
-        std::vector<std::vector<char>> row_datas(num_queries * topk);
+        std::vector<const char*> row_datas(num_queries * topk);
+        int64_t row_data_sizeof = -1;
 
         std::vector<int64_t> counts(num_segments);
         for (int i = 0; i < num_segments; i++) {
@@ -160,11 +221,14 @@ ReorganizeSearchResults(CMarshaledHits* c_marshaled_hits, CSearchResult* c_searc
             if (size == 0) {
                 continue;
             }
+            AssertInfo(row_data_sizeof == -1 || row_data_sizeof == search_result->row_data_sizeof_,
+                       "row data of search results mismatch");
+            row_data_sizeof = search_result->row_data_sizeof_;
 #pragma omp parallel for
             for (int j = 0; j < size; j++) {
                 auto loc = search_result->result_offsets_[j];
                 result_distances[loc] = search_result->result_distances_[j];
-                row_datas[loc] = search_result->row_data_[j];
+                row_datas[loc] = search_result->get_row_data(j);
             }
             counts[i] = size;
         }
@@ -181,12 +245,17 @@ ReorganizeSearchResults(CMarshaledHits* c_marshaled_hits, CSearchResult* c_searc
         std::vector<milvus::proto::milvus::Hits> hits(num_queries);
 #pragma omp parallel for
         for (int m = 0; m < num_queries; m++) {
+            hits[m].mutable_scores()->Reserve(topk);
+            hits[m].mutable_ids()->Reserve(topk);
+            hits[m].mutable_row_data()->Reserve(topk);
             for (int n = 0; n < topk; n++) {
                 int64_t result_offset = m * topk + n;
                 hits[m].add_scores(result_distances[result_offset]);
-                auto& row_data = row_datas[result_offset];
-                hits[m].add_row_data(row_data.data(), row_data.size());
-                hits[m].add_ids(*(int64_t*)row_data.data());
+                auto row_data = row_datas[result_offset];
+                hits[m].add_row_data(row_data, row_data_sizeof);
+                int64_t id;
+                memcpy(&id, row_data, sizeof(id));
+                hits[m].add_ids(id);
             }
         }
 
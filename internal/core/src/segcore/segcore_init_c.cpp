@@ -11,6 +11,7 @@
 
 #include "index/thirdparty/faiss/FaissHook.h"
 #include "segcore/segcore_init_c.h"
+#include "segcore/IndexingExecutor.h"
 #include "knowhere/archive/KnowhereConfig.h"
 #include <iostream>
 #include "utils/Log.h"
@@ -33,3 +34,8 @@ extern "C" void
 SegcoreInit() {
     milvus::segcore::SegcoreInitImpl();
 }
+
+extern "C" void
+SegcoreSetIndexBuildThreadNum(int64_t thread_num) {
+    milvus::segcore::IndexingExecutor::GetInstance().SetThreadNum(thread_num);
+}
@@ -12,9 +12,16 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+
 void
 SegcoreInit();
 
+// number of threads building small indexes of growing segments in background,
+// 0 builds them synchronously during insert
+void
+SegcoreSetIndexBuildThreadNum(int64_t thread_num);
+
 #ifdef __cplusplus
 }
 #endif
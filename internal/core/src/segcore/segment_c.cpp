@@ -11,6 +11,11 @@
 
 #include <cstring>
 #include <cstdint>
+#include <memory>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "segcore/SegmentGrowing.h"
 #include "segcore/SegmentSealed.h"
@@ -21,6 +26,7 @@
 #include <knowhere/index/vector_index/VecIndex.h>
 #include <knowhere/index/vector_index/adapter/VectorAdapter.h>
 #include "common/Types.h"
+#include "common/SystemProperty.h"
 #include "common/CGoHelper.h"
 #include <iostream>
 
@@ -95,6 +101,23 @@ GetMemoryUsageInBytes(CSegmentInterface c_segment) {
     return mem_size;
 }
 
+CMemoryUsage
+GetMemoryUsage(CSegmentInterface c_segment) {
+    auto segment = (milvus::segcore::SegmentInterface*)c_segment;
+    auto usage = segment->GetMemoryUsage();
+    CMemoryUsage c_usage;
+    c_usage.field_data = usage.field_data;
+    c_usage.system_field_data = usage.system_field_data;
+    c_usage.vector_index = usage.vector_index;
+    c_usage.scalar_index = usage.scalar_index;
+    c_usage.primary_key_index = usage.primary_key_index;
+    c_usage.timestamp_index = usage.timestamp_index;
+    c_usage.delete_record = usage.delete_record;
+    c_usage.cache = usage.cache;
+    c_usage.total = usage.total();
+    return c_usage;
+}
+
 int64_t
 GetRowCount(CSegmentInterface c_segment) {
     auto segment = (milvus::segcore::SegmentInterface*)c_segment;
@@ -184,6 +207,90 @@ LoadFieldData(CSegmentInterface c_segment, CLoadFieldDataInfo load_field_data_in
     }
 }
 
+CStatus
+LoadSegment(CSegmentInterface c_segment, const CLoadFieldDataInfo* load_field_data_infos, int64_t num_fields) {
+    try {
+        auto segment_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        std::vector<LoadFieldDataInfo> load_infos;
+        for (int64_t i = 0; i < num_fields; ++i) {
+            auto& info = load_field_data_infos[i];
+            load_infos.push_back(LoadFieldDataInfo{info.field_id, info.blob, info.row_count});
+        }
+        segment->LoadSegment(load_infos);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+CStatus
+LoadFieldDataWithRelease(CSegmentInterface c_segment,
+                         CLoadFieldDataInfo load_field_data_info,
+                         CReleaseCallback release,
+                         void* release_arg) {
+    if (release == nullptr) {
+        return milvus::FailureCStatus(UnexpectedError, "release callback is null");
+    }
+    // released once both this frame and the loaded column let go of it, so a failed load releases it too
+    auto blob = std::shared_ptr<void>(release_arg, [release](void* arg) { release(arg); });
+    try {
+        auto segment_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        auto load_info =
+            LoadFieldDataInfo{load_field_data_info.field_id, load_field_data_info.blob, load_field_data_info.row_count};
+        load_info.release = [blob]() mutable { blob.reset(); };
+        segment->LoadFieldData(load_info);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+CStatus
+LoadFieldDataFromFile(CSegmentInterface c_segment, int64_t field_id, const char* path, int64_t row_count) {
+    try {
+        auto segment_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        AssertInfo(row_count > 0, "invalid row count");
+        auto fid = milvus::FieldId(field_id);
+        auto& schema = segment->get_schema();
+        int64_t element_sizeof = milvus::SystemProperty::Instance().IsSystem(fid)
+                                     ? sizeof(int64_t)
+                                     : schema[schema.get_offset(fid)].get_sizeof();
+
+        auto fd = open(path, O_RDONLY);
+        AssertInfo(fd != -1, std::string("failed to open ") + path);
+        struct stat st;
+        auto ret = fstat(fd, &st);
+        auto size = st.st_size;
+        if (ret == -1 || size < element_sizeof * row_count) {
+            close(fd);
+            PanicInfo(std::string("column file too small: ") + path);
+        }
+        auto addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        // the mapping stays valid after the descriptor is closed
+        close(fd);
+        AssertInfo(addr != MAP_FAILED, std::string("failed to mmap ") + path);
+        // unmapped once both this frame and the loaded column let go of it,
+        // so a load failing before the column takes over doesn't leak the mapping
+        auto mapping = std::shared_ptr<void>(addr, [size](void* addr) { munmap(addr, size); });
+
+        LoadFieldDataInfo load_info;
+        load_info.field_id = field_id;
+        load_info.blob = addr;
+        load_info.row_count = row_count;
+        load_info.release = [mapping]() mutable { mapping.reset(); };
+        segment->LoadFieldData(load_info);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
 CStatus
 UpdateSealedSegmentIndex(CSegmentInterface c_segment, CLoadIndexInfo c_load_index_info) {
     try {
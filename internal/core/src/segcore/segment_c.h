@@ -50,6 +50,9 @@ Retrieve(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp);
 int64_t
 GetMemoryUsageInBytes(CSegmentInterface c_segment);
 
+CMemoryUsage
+GetMemoryUsage(CSegmentInterface c_segment);
+
 int64_t
 GetRowCount(CSegmentInterface c_segment);
 
@@ -84,6 +87,26 @@ PreDelete(CSegmentInterface c_segment, int64_t size);
 CStatus
 LoadFieldData(CSegmentInterface c_segment, CLoadFieldDataInfo load_field_data_info);
 
+// load all fields of a segment in one call, either all of them are loaded or none
+CStatus
+LoadSegment(CSegmentInterface c_segment, const CLoadFieldDataInfo* load_field_data_infos, int64_t num_fields);
+
+// load a field without copying its blob, the segment keeps it until the field is dropped.
+// release(release_arg) is called exactly once, on drop or when the load fails,
+// e.g. with the values of a payload chunk and a callback releasing the chunk
+typedef void (*CReleaseCallback)(void* release_arg);
+
+CStatus
+LoadFieldDataWithRelease(CSegmentInterface c_segment,
+                         CLoadFieldDataInfo load_field_data_info,
+                         CReleaseCallback release,
+                         void* release_arg);
+
+// load a field from a raw column file, which is mmapped instead of copied
+// and unmapped when the field is dropped
+CStatus
+LoadFieldDataFromFile(CSegmentInterface c_segment, int64_t field_id, const char* path, int64_t row_count);
+
 CStatus
 UpdateSealedSegmentIndex(CSegmentInterface c_segment, CLoadIndexInfo c_load_index_info);
 
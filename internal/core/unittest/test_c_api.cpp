@@ -14,6 +14,7 @@
 #include <random>
 #include <gtest/gtest.h>
 #include <chrono>
+#include <set>
 #include <google/protobuf/text_format.h>
 
 #include "pb/milvus.pb.h"
@@ -23,6 +24,7 @@
 #include <index/knowhere/knowhere/index/vector_index/adapter/VectorAdapter.h>
 #include <index/knowhere/knowhere/index/vector_index/VecIndexFactory.h>
 #include <index/knowhere/knowhere/index/vector_index/IndexIVFPQ.h>
+#include <index/knowhere/knowhere/common/Utils.h>
 #include <common/LoadInfo.h>
 #include <utils/Types.h>
 #include <segcore/Collection.h>
@@ -343,9 +345,12 @@ TEST(CApiTest, GetMemoryUsageInBytesTest) {
     auto collection = NewCollection(get_default_schema_config());
     auto segment = NewSegment(collection, 0, Growing);
 
-    auto old_memory_usage_size = GetMemoryUsageInBytes(segment);
-    // std::cout << "old_memory_usage_size = " << old_memory_usage_size << std::endl;
-    assert(old_memory_usage_size == 0);
+    // only the empty primary key table is allocated up front
+    auto old_memory_usage = GetMemoryUsage(segment);
+    ASSERT_EQ(old_memory_usage.field_data, 0);
+    ASSERT_EQ(old_memory_usage.system_field_data, 0);
+    ASSERT_EQ(old_memory_usage.total, old_memory_usage.primary_key_index);
+    ASSERT_EQ(GetMemoryUsageInBytes(segment), old_memory_usage.total);
 
     int N = 10000;
     auto [raw_data, timestamps, uids] = generate_data(N);
@@ -357,9 +362,15 @@ TEST(CApiTest, GetMemoryUsageInBytesTest) {
     auto res = Insert(segment, offset, N, uids.data(), timestamps.data(), raw_data.data(), (int)line_sizeof, N);
     assert(res.error_code == Success);
 
-    auto memory_usage_size = GetMemoryUsageInBytes(segment);
-    // std::cout << "new_memory_usage_size = " << memory_usage_size << std::endl;
-    assert(memory_usage_size == 2785280);
+    // a single chunk of 32768 rows
+    auto memory_usage = GetMemoryUsage(segment);
+    ASSERT_EQ(memory_usage.field_data, 32768 * line_sizeof);
+    ASSERT_EQ(memory_usage.system_field_data, 32768 * (sizeof(int64_t) + sizeof(Timestamp)));
+    ASSERT_GE(memory_usage.primary_key_index, N * 2 * (sizeof(int64_t) * 2));
+    ASSERT_EQ(memory_usage.vector_index, 0);
+    ASSERT_EQ(memory_usage.total, memory_usage.field_data + memory_usage.system_field_data +
+                                      memory_usage.primary_key_index + memory_usage.delete_record);
+    ASSERT_EQ(GetMemoryUsageInBytes(segment), memory_usage.total);
 
     DeleteCollection(collection);
     DeleteSegment(segment);
@@ -504,6 +515,22 @@ TEST(CApiTest, Reduce) {
 
     status = ReduceSearchResultsAndFillData(plan, results.data(), results.size());
     assert(status.error_code == Success);
+
+    // the same segment is searched twice, so every entity must be kept only once per query
+    int64_t topk = 10;
+    std::vector<int64_t> reduced_keys(num_queries * topk, -1);
+    for (auto c_result : results) {
+        auto search_result = (SearchResult*)c_result;
+        ASSERT_EQ(search_result->result_offsets_.size(), search_result->primary_keys_.size());
+        for (int64_t i = 0; i < search_result->result_offsets_.size(); ++i) {
+            reduced_keys[search_result->result_offsets_[i]] = search_result->primary_keys_[i];
+        }
+    }
+    for (int64_t q = 0; q < num_queries; ++q) {
+        std::set<int64_t> keys(reduced_keys.begin() + q * topk, reduced_keys.begin() + (q + 1) * topk);
+        ASSERT_EQ(keys.size(), topk);
+        ASSERT_EQ(keys.count(-1), 0);
+    }
     void* reorganize_search_result = nullptr;
     status = ReorganizeSearchResults(&reorganize_search_result, results.data(), results.size());
     assert(status.error_code == Success);
@@ -648,6 +675,100 @@ TEST(CApiTest, LoadIndexInfo) {
     DeleteLoadIndexInfo(c_load_index_info);
 }
 
+TEST(CApiTest, LoadSlicedIndexInPlace) {
+    constexpr auto TOPK = 10;
+
+    auto N = 1024 * 10;
+    auto [raw_data, timestamps, uids] = generate_data(N);
+    auto indexing = std::make_shared<milvus::knowhere::IVFPQ>();
+    auto conf = milvus::knowhere::Config{{milvus::knowhere::meta::DIM, DIM},
+                                         {milvus::knowhere::meta::TOPK, TOPK},
+                                         {milvus::knowhere::IndexParams::nlist, 100},
+                                         {milvus::knowhere::IndexParams::nprobe, 4},
+                                         {milvus::knowhere::IndexParams::m, 4},
+                                         {milvus::knowhere::IndexParams::nbits, 8},
+                                         {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+                                         {milvus::knowhere::meta::DEVICEID, 0}};
+
+    auto database = milvus::knowhere::GenDataset(N, DIM, raw_data.data());
+    indexing->Train(database, conf);
+    indexing->AddWithoutIds(database, conf);
+    auto binary_set = indexing->Serialize(conf);
+    milvus::knowhere::Disassemble(4096, binary_set);
+    auto slices = milvus::knowhere::GetSlices(binary_set, "IVF");
+    ASSERT_GT(slices.size(), 1);
+
+    // read every slice of IVF straight into its place, other keys as they are
+    CBinarySet c_binary_set;
+    auto status = NewBinarySet(&c_binary_set);
+    ASSERT_EQ(status.error_code, Success);
+    int64_t total_size = 0;
+    for (auto& slice : slices) {
+        total_size += slice->size;
+    }
+    void* buffer = nullptr;
+    status = AllocateBinaryIndex(c_binary_set, "IVF", total_size, &buffer);
+    ASSERT_EQ(status.error_code, Success);
+    for (auto& slice : slices) {
+        memcpy(buffer, slice->data.get(), slice->size);
+        buffer = (uint8_t*)buffer + slice->size;
+    }
+    for (auto& [key, binary] : binary_set.binary_map_) {
+        if (key.rfind("IVF_", 0) != 0) {
+            status = AppendBinaryIndex(c_binary_set, binary->data.get(), binary->size, key.c_str());
+            ASSERT_EQ(status.error_code, Success);
+        }
+    }
+
+    CLoadIndexInfo c_load_index_info;
+    status = NewLoadIndexInfo(&c_load_index_info);
+    ASSERT_EQ(status.error_code, Success);
+    AppendIndexParam(c_load_index_info, "index_type", "IVF_PQ");
+    AppendFieldInfo(c_load_index_info, 0);
+    status = AppendIndex(c_load_index_info, c_binary_set);
+    ASSERT_EQ(status.error_code, Success);
+
+    auto query_dataset = milvus::knowhere::GenDataset(10, DIM, raw_data.data() + DIM * 4200);
+    auto loaded = ((LoadIndexInfo*)c_load_index_info)->index->Query(query_dataset, conf, nullptr);
+    auto expected = indexing->Query(query_dataset, conf, nullptr);
+    auto loaded_ids = loaded->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto expected_ids = expected->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int i = 0; i < 10 * TOPK; ++i) {
+        ASSERT_EQ(loaded_ids[i], expected_ids[i]);
+    }
+    DeleteLoadIndexInfo(c_load_index_info);
+    DeleteBinarySet(c_binary_set);
+}
+
+TEST(CApiTest, AssembleCopiesBorrowedBinary) {
+    std::vector<uint8_t> borrowed(100, 1);
+
+    // a single slice and a full key borrowing the caller's memory, plus a full key in a loader owned buffer
+    std::string meta = R"({"meta":[{"name":"borrowed","slice_num":1,"total_len":100},)"
+                       R"({"name":"full","slice_num":1,"total_len":100},)"
+                       R"({"name":"allocated","slice_num":1,"total_len":100}]})";
+    CBinarySet c_binary_set;
+    auto status = NewBinarySet(&c_binary_set);
+    ASSERT_EQ(status.error_code, Success);
+    AppendBinaryIndex(c_binary_set, &meta[0], meta.size(), milvus::knowhere::INDEX_FILE_SLICE_META);
+    AppendBinaryIndex(c_binary_set, borrowed.data(), borrowed.size(), "borrowed_0");
+    AppendBinaryIndex(c_binary_set, borrowed.data(), borrowed.size(), "full");
+    void* buffer = nullptr;
+    AllocateBinaryIndex(c_binary_set, "allocated", borrowed.size(), &buffer);
+    memcpy(buffer, borrowed.data(), borrowed.size());
+
+    auto& binary_set = *(milvus::knowhere::BinarySet*)c_binary_set;
+    milvus::knowhere::Assemble(binary_set);
+    for (auto key : {"borrowed", "full"}) {
+        auto binary = binary_set.GetByName(key);
+        ASSERT_NE(binary->data.get(), borrowed.data());
+        ASSERT_TRUE(binary->owned);
+        ASSERT_EQ(memcmp(binary->data.get(), borrowed.data(), borrowed.size()), 0);
+    }
+    ASSERT_EQ(binary_set.GetByName("allocated")->data.get(), buffer);
+    DeleteBinarySet(c_binary_set);
+}
+
 TEST(CApiTest, LoadIndex_Search) {
     // generator index
     constexpr auto TOPK = 10;
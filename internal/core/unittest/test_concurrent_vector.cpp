@@ -16,6 +16,7 @@
 #include <string>
 #include <thread>
 #include <vector>
+#include <numeric>
 
 #include "segcore/ConcurrentVector.h"
 #include "segcore/SegmentGrowing.h"
@@ -23,6 +24,7 @@
 
 #include "segcore/SegmentGrowing.h"
 #include "segcore/AckResponder.h"
+#include "segcore/PkHashIndex.h"
 
 using std::cin;
 using std::cout;
@@ -109,6 +111,40 @@ TEST(ConcurrentVector, TestMultithreads) {
         }
     }
 }
+
+TEST(ConcurrentVector, TestThreadSafeVector) {
+    ThreadSafeVector<std::vector<int64_t>> vec;
+    constexpr int64_t N = 5000;
+    std::atomic<bool> done = false;
+    // readers run while the writer keeps appending
+    auto reader = [&] {
+        while (!done) {
+            auto size = vec.size();
+            for (int64_t i = 0; i < size; ++i) {
+                ASSERT_EQ(vec[i].size(), 3);
+            }
+        }
+    };
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back(reader);
+    }
+    std::vector<const std::vector<int64_t>*> addresses;
+    for (int64_t i = 1; i <= N; ++i) {
+        vec.emplace_to_at_least(i, 3);
+        addresses.push_back(&vec[i - 1]);
+    }
+    done = true;
+    for (auto& thread : readers) {
+        thread.join();
+    }
+    ASSERT_EQ(vec.size(), N);
+    // elements never move
+    for (int64_t i = 0; i < N; ++i) {
+        ASSERT_EQ(&vec[i], addresses[i]);
+    }
+}
+
 TEST(ConcurrentVector, TestAckSingle) {
     std::vector<std::tuple<int64_t, int64_t, int64_t>> raw_data;
     std::default_random_engine e(42);
@@ -127,3 +163,73 @@ TEST(ConcurrentVector, TestAckSingle) {
     }
     EXPECT_EQ(ack.GetAck(), N);
 }
+
+TEST(ConcurrentVector, TestAckMultithreads) {
+    constexpr int threads = 16;
+    AckResponder ack;
+    std::atomic<int64_t> reserved = 0;
+    auto executor = [&](int thread_id) {
+        std::default_random_engine e(42 + thread_id);
+        int64_t last_ack = 0;
+        for (int i = 0; i < 10000; ++i) {
+            auto size = e() % 10;
+            auto begin = reserved.fetch_add(size);
+            if (e() % 4 == 0) {
+                std::this_thread::yield();
+            }
+            ack.AddSegment(begin, begin + size);
+            auto current = ack.GetAck();
+            ASSERT_GE(current, last_ack);
+            last_ack = current;
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i) {
+        pool.emplace_back(executor, i);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    ASSERT_EQ(ack.GetAck(), reserved.load());
+}
+
+TEST(ConcurrentVector, TestPkHashIndex) {
+    PkHashIndex index;
+    int num_threads = 4;
+    int64_t rows_per_thread = 20000;
+    int64_t batch = 500;
+    int64_t num_keys = 30000;
+    std::vector<std::thread> threads;
+    for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+        threads.emplace_back([&, thread_id] {
+            std::vector<int64_t> ids(batch);
+            for (int64_t begin = 0; begin < rows_per_thread; begin += batch) {
+                auto base = thread_id * rows_per_thread + begin;
+                // keys repeat across threads
+                for (int64_t i = 0; i < batch; ++i) {
+                    ids[i] = (base + i) % num_keys;
+                }
+                index.insert(ids.data(), batch, base);
+            }
+        });
+    }
+    // lookups run along with inserts
+    int64_t probe = 1;
+    for (int round = 0; round < 100; ++round) {
+        index.for_each_offset(&probe, 1, [&](int64_t, int64_t offset) { ASSERT_EQ(offset % num_keys, probe); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(index.size(), num_threads * rows_per_thread);
+
+    std::vector<int64_t> keys(num_keys);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::vector<int> counts(num_keys);
+    index.for_each_offset(keys.data(), num_keys, [&](int64_t i, int64_t offset) {
+        ASSERT_EQ(offset % num_keys, keys[i]);
+        ++counts[i];
+    });
+    ASSERT_EQ(std::accumulate(counts.begin(), counts.end(), 0), num_threads * rows_per_thread);
+    ASSERT_GT(index.memory_usage_in_bytes(), 0);
+}
@@ -18,6 +18,7 @@
 #include "test_utils/DataGen.h"
 #include "query/generated/ShowPlanNodeVisitor.h"
 #include "query/generated/ExecExprVisitor.h"
+#include "query/ExprKernel.h"
 #include "query/Plan.h"
 #include "utils/tools.h"
 #include <regex>
@@ -583,3 +584,210 @@ TEST(Expr, TestCompare) {
         }
     }
 }
+
+TEST(Expr, PredicateKernel) {
+    using namespace milvus::query;
+    std::default_random_engine e(42);
+    for (int64_t size : {1, 63, 64, 65, 1000, 32 * 1024}) {
+        std::vector<int32_t> left(size);
+        std::vector<double> right(size);
+        for (int64_t i = 0; i < size; ++i) {
+            left[i] = e() % 100;
+            right[i] = e() % 1000 / 10.0;
+        }
+        boost::dynamic_bitset<> unary(size);
+        boost::dynamic_bitset<> binary(size);
+        UnaryPredicateKernel(left.data(), size, [](int32_t x) { return x >= 42; }, get_words(unary));
+        BinaryPredicateKernel(left.data(), right.data(), size, std::less<>{}, get_words(binary));
+        for (int64_t i = 0; i < size; ++i) {
+            ASSERT_EQ(unary[i], left[i] >= 42) << i;
+            ASSERT_EQ(binary[i], left[i] < right[i]) << i;
+        }
+        // words without any row in the mask are cleared rather than evaluated
+        boost::dynamic_bitset<> mask(size);
+        for (int64_t i = 0; i < size; i += 129) {
+            mask[i] = true;
+        }
+        boost::dynamic_bitset<> masked(size);
+        UnaryPredicateKernel(
+            left.data(), size, [](int32_t x) { return x >= 42; }, get_words(masked), get_words(mask));
+        for (int64_t i = 0; i < size; ++i) {
+            auto word_begin = i / BITS_PER_WORD * BITS_PER_WORD;
+            auto live = HasSetBit(get_words(mask), word_begin, std::min(size, word_begin + BITS_PER_WORD));
+            ASSERT_EQ(masked[i], live && unary[i]) << i;
+        }
+        // tail bits must stay cleared
+        unary.resize(upper_align(size, BITS_PER_WORD));
+        binary.resize(upper_align(size, BITS_PER_WORD));
+        ASSERT_FALSE((unary >> size).any());
+        ASSERT_FALSE((binary >> size).any());
+    }
+}
+
+TEST(Expr, CopyBits) {
+    using namespace milvus::query;
+    std::default_random_engine e(42);
+    for (int64_t size_per_chunk : {7, 64, 100, 1000}) {
+        int64_t total = size_per_chunk * 5 - 3;
+        boost::dynamic_bitset<> src(total);
+        for (int64_t i = 0; i < total; ++i) {
+            src[i] = e() % 2;
+        }
+        boost::dynamic_bitset<> dst(total);
+        for (int64_t offset = 0; offset < total; offset += size_per_chunk) {
+            auto size = std::min(size_per_chunk, total - offset);
+            boost::dynamic_bitset<> chunk(size);
+            for (int64_t i = 0; i < size; ++i) {
+                chunk[i] = src[offset + i];
+            }
+            std::vector<uint64_t> stored(upper_div(size, BITS_PER_WORD), ~uint64_t(0));
+            StoreBits(stored.data(), get_words(chunk), size);
+            CopyBits(get_words(dst), offset, stored.data(), size);
+        }
+        ASSERT_EQ(src, dst);
+    }
+}
+
+template <typename T>
+static query::ExprPtr
+MakeRangeExpr(FieldOffset field_offset, DataType data_type, query::OpType op, T value) {
+    auto expr = std::make_unique<query::UnaryRangeExprImpl<T>>();
+    expr->field_offset_ = field_offset;
+    expr->data_type_ = data_type;
+    expr->op_type_ = op;
+    expr->value_ = value;
+    return expr;
+}
+
+static query::ExprPtr
+MakeLogicalExpr(query::LogicalBinaryExpr::OpType op, query::ExprPtr left, query::ExprPtr right) {
+    auto expr = std::make_unique<query::LogicalBinaryExpr>();
+    expr->op_type_ = op;
+    expr->left_ = std::move(left);
+    expr->right_ = std::move(right);
+    return expr;
+}
+
+static query::ExprPtr
+MakeNotExpr(query::ExprPtr child) {
+    auto expr = std::make_unique<query::LogicalUnaryExpr>();
+    expr->op_type_ = query::LogicalUnaryExpr::OpType::LogicalNot;
+    expr->child_ = std::move(child);
+    return expr;
+}
+
+TEST(Expr, TestLogicalChain) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    using LogicalOp = LogicalBinaryExpr::OpType;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::INT32);
+    schema->AddDebugField("id", DataType::INT64);
+    auto age = [](OpType op, int32_t value) { return MakeRangeExpr(FieldOffset(1), DataType::INT32, op, value); };
+    auto id = [](OpType op, int64_t value) { return MakeRangeExpr(FieldOffset(2), DataType::INT64, op, value); };
+    auto age_in = [](std::vector<int32_t> values) -> ExprPtr {
+        auto expr = std::make_unique<TermExprImpl<int32_t>>();
+        expr->field_offset_ = FieldOffset(1);
+        expr->data_type_ = DataType::INT32;
+        expr->terms_.assign(values.begin(), values.end());
+        return expr;
+    };
+    auto age_lt_id = [] {
+        auto expr = std::make_unique<CompareExpr>();
+        expr->left_field_offset_ = FieldOffset(1);
+        expr->right_field_offset_ = FieldOffset(2);
+        expr->left_data_type_ = DataType::INT32;
+        expr->right_data_type_ = DataType::INT64;
+        expr->op_type_ = OpType::LessThan;
+        return expr;
+    };
+
+    std::vector<std::tuple<std::string, std::function<ExprPtr()>, std::function<bool(int32_t, int64_t)>>> testcases = {
+        {"and",
+         [&] {
+             return MakeLogicalExpr(
+                 LogicalOp::LogicalAnd,
+                 MakeLogicalExpr(LogicalOp::LogicalAnd, age(OpType::LessThan, 2000), id(OpType::GreaterEqual, 5000)),
+                 age(OpType::NotEqual, 7));
+         },
+         [](int32_t a, int64_t i) { return a < 2000 && i >= 5000 && a != 7; }},
+        {"or",
+         [&] {
+             return MakeLogicalExpr(
+                 LogicalOp::LogicalOr,
+                 MakeLogicalExpr(LogicalOp::LogicalOr, age(OpType::LessThan, 100), id(OpType::LessThan, 10)),
+                 age(OpType::GreaterThan, 19900));
+         },
+         [](int32_t a, int64_t i) { return a < 100 || i < 10 || a > 19900; }},
+        {"not_and_or",
+         [&] {
+             return MakeLogicalExpr(
+                 LogicalOp::LogicalAnd, MakeNotExpr(age(OpType::LessThan, 10000)),
+                 MakeLogicalExpr(LogicalOp::LogicalOr, id(OpType::LessThan, 3000), age(OpType::Equal, 10042)));
+         },
+         [](int32_t a, int64_t i) { return !(a < 10000) && (i < 3000 || a == 10042); }},
+        {"minus",
+         [&] {
+             return MakeLogicalExpr(LogicalOp::LogicalMinus, age(OpType::GreaterEqual, 5000),
+                                    id(OpType::LessThan, 5000));
+         },
+         [](int32_t a, int64_t i) { return a >= 5000 && !(i < 5000); }},
+        {"xor_in_and",
+         [&] {
+             return MakeLogicalExpr(
+                 LogicalOp::LogicalAnd,
+                 MakeLogicalExpr(LogicalOp::LogicalXor, age(OpType::LessThan, 5000), id(OpType::LessThan, 5000)),
+                 age(OpType::GreaterThan, 1000));
+         },
+         [](int32_t a, int64_t i) { return ((a < 5000) != (i < 5000)) && a > 1000; }},
+        {"empty_and",
+         [&] {
+             return MakeLogicalExpr(LogicalOp::LogicalAnd, age(OpType::LessThan, 0),
+                                    MakeNotExpr(id(OpType::LessThan, 100)));
+         },
+         [](int32_t a, int64_t i) { return false; }},
+        {"term_compare",
+         [&] {
+             return MakeLogicalExpr(
+                 LogicalOp::LogicalAnd,
+                 MakeLogicalExpr(LogicalOp::LogicalOr, age_in({1, 2, 3, 500, 4000}), id(OpType::GreaterThan, 9990)),
+                 MakeNotExpr(age_lt_id()));
+         },
+         [](int32_t a, int64_t i) {
+             return (a == 1 || a == 2 || a == 3 || a == 500 || a == 4000 || i > 9990) && !(a < i);
+         }},
+    };
+
+    // chunks of 1000 rows don't start at word boundaries
+    for (int64_t size_per_chunk : {1000, 32 * 1024}) {
+        auto seg_conf = SegcoreConfig::default_config();
+        seg_conf.set_size_per_chunk(size_per_chunk);
+        auto seg = CreateGrowingSegment(schema, seg_conf);
+        int N = 10000;
+        std::vector<int32_t> age_col;
+        std::vector<int64_t> id_col;
+        int num_iters = 10;
+        for (int iter = 0; iter < num_iters; ++iter) {
+            auto raw_data = DataGen(schema, N, iter);
+            auto new_age_col = raw_data.get_col<int32_t>(1);
+            auto new_id_col = raw_data.get_col<int64_t>(2);
+            age_col.insert(age_col.end(), new_age_col.begin(), new_age_col.end());
+            id_col.insert(id_col.end(), new_id_col.begin(), new_id_col.end());
+            seg->PreInsert(N);
+            seg->Insert(iter * N, N, raw_data.row_ids_.data(), raw_data.timestamps_.data(), raw_data.raw_);
+        }
+
+        auto seg_promote = dynamic_cast<SegmentGrowingImpl*>(seg.get());
+        ExecExprVisitor visitor(*seg_promote, seg_promote->get_row_count(), MAX_TIMESTAMP);
+        for (auto& [name, make_expr, ref_func] : testcases) {
+            auto expr = make_expr();
+            auto final = visitor.call_child(*expr);
+            EXPECT_EQ(final.size(), N * num_iters);
+            for (int i = 0; i < N * num_iters; ++i) {
+                ASSERT_EQ(final[i], ref_func(age_col[i], id_col[i]))
+                    << name << "@" << i << boost::format("[%1%, %2%]") % age_col[i] % id_col[i];
+            }
+        }
+    }
+}
@@ -12,6 +12,8 @@
 #include <gtest/gtest.h>
 #include "test_utils/DataGen.h"
 #include "segcore/ScalarIndex.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include <map>
 #include "query/ExprImpl.h"
 using namespace milvus;
 using namespace milvus::segcore;
@@ -152,6 +154,65 @@ TEST(Retrieve, AUTOID) {
     ASSERT_EQ(field1_data.data_size(), DIM * req_size);
 }
 
+TEST(Retrieve, OffsetLimit) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    auto DIM = 16;
+    auto fid_vec = schema->AddDebugField("vector_64", DataType::VECTOR_FLOAT, DIM, MetricType::METRIC_L2);
+    schema->set_primary_key(FieldOffset(0));
+
+    int64_t N = 1000;
+    auto dataset = DataGen(schema, N);
+    auto i64_col = dataset.get_col<int64_t>(0);
+
+    // every third row matches, timestamps of DataGen are 0, 1, 2, ...
+    boost::dynamic_bitset<> bitset(N);
+    for (int64_t i = 0; i < N; i += 3) {
+        bitset.set(i);
+    }
+    auto growing = CreateGrowingSegment(schema);
+    growing->PreInsert(N);
+    growing->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+    auto sealed = CreateSealedSegment(schema);
+    SealedLoader(dataset, *sealed);
+    for (auto segment : {static_cast<const SegmentInternalInterface*>(growing.get()),
+                         static_cast<const SegmentInternalInterface*>(sealed.get())}) {
+        auto all = segment->search_ids(bitset, MAX_TIMESTAMP, 0, N);
+        ASSERT_EQ(all.size(), (N + 2) / 3);
+        // the row written at 300 is visible at 300
+        auto visible = segment->search_ids(bitset, 300, 0, N);
+        ASSERT_EQ(visible.size(), 101);
+        ASSERT_EQ(visible.back(), SegOffset(300));
+        auto window = segment->search_ids(bitset, 300, 95, 10);
+        ASSERT_EQ(window.size(), 6);
+        for (int i = 0; i < window.size(); ++i) {
+            ASSERT_EQ(window[i], SegOffset((95 + i) * 3));
+        }
+        ASSERT_TRUE(segment->search_ids(bitset, MAX_TIMESTAMP, 0, 0).empty());
+    }
+
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+    auto term_expr = std::make_unique<query::TermExprImpl<int64_t>>();
+    term_expr->field_offset_ = FieldOffset(0);
+    term_expr->data_type_ = DataType::INT64;
+    for (int64_t i = 0; i < N; ++i) {
+        term_expr->terms_.emplace_back(i64_col[i]);
+    }
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->predicate_ = std::move(term_expr);
+    plan->plan_node_->offset_ = 10;
+    plan->plan_node_->limit_ = 20;
+    plan->field_offsets_ = std::vector<FieldOffset>{FieldOffset(0)};
+
+    // a segment returns the first offset + limit matches, the offset is applied after the merge
+    auto retrieve_results = sealed->Retrieve(plan.get(), N);
+    auto field0_data = retrieve_results->fields_data(0).scalars().long_data();
+    ASSERT_EQ(field0_data.data_size(), 30);
+    for (int i = 0; i < 30; ++i) {
+        ASSERT_EQ(field0_data.data(i), i64_col[i]);
+    }
+}
+
 TEST(GetEntityByIds, PrimaryKey) {
     auto schema = std::make_shared<Schema>();
     auto fid_64 = schema->AddDebugField("counter_i64", DataType::INT64);
@@ -209,3 +270,98 @@ TEST(GetEntityByIds, PrimaryKey) {
     //        }
     //    }
 }
+
+TEST(GetEntityByIds, ScalarIndexBatch) {
+    std::default_random_engine e(42);
+    int64_t N = 10000;
+    // repeated keys stand for multiple versions of the same entity
+    std::vector<int64_t> data(N);
+    std::vector<Timestamp> timestamps(N);
+    for (int64_t i = 0; i < N; ++i) {
+        data[i] = e() % (N / 2);
+        timestamps[i] = i;
+    }
+    ScalarIndexVector index;
+    index.append_data(data.data(), N, SegOffset(0));
+    index.build();
+
+    // sparse and dense probes, with duplicates and missing keys
+    std::vector<int64_t> probes;
+    for (int i = 0; i < 3000; ++i) {
+        probes.push_back(e() % N);
+    }
+    probes.push_back(probes.front());
+    Timestamp query_ts = N / 2;
+
+    std::vector<int64_t> res_ids;
+    std::vector<SegOffset> res_offsets;
+    index.search_ids_batch(probes.data(), probes.size(), timestamps.data(), query_ts, res_ids, res_offsets);
+
+    std::map<int64_t, int64_t> expected;
+    for (auto id : probes) {
+        for (int64_t i = 0; i < N; ++i) {
+            if (data[i] == id && timestamps[i] <= query_ts) {
+                expected[id] = std::max(expected.count(id) ? expected[id] : int64_t(-1), i);
+            }
+        }
+    }
+    ASSERT_EQ(res_ids.size(), expected.size());
+    int64_t index_in_res = 0;
+    for (auto [id, offset] : expected) {
+        ASSERT_EQ(res_ids[index_in_res], id);
+        ASSERT_EQ(res_offsets[index_in_res].get(), offset);
+        ++index_in_res;
+    }
+}
+
+TEST(GetEntityByIds, ScalarIndexAtTimestamp) {
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    auto dataset = DataGen(schema, N);
+    auto sealed = CreateSealedSegment(schema);
+    SealedLoader(dataset, *sealed);
+
+    // row ids and timestamps of DataGen are 0, 1, 2, ..., a row is visible at its own timestamp
+    Timestamp query_ts = N / 2;
+    boost::dynamic_bitset<> mask;
+    sealed->mask_with_timestamps(mask, query_ts);
+
+    ScalarIndexVector index;
+    index.append_data(dataset.row_ids_.data(), N, SegOffset(0));
+    index.build();
+    std::vector<int64_t> probes = {N / 2 - 1, N / 2, N / 2 + 1};
+    std::vector<int64_t> res_ids;
+    std::vector<SegOffset> res_offsets;
+    index.search_ids_batch(probes.data(), probes.size(), dataset.timestamps_.data(), query_ts, res_ids, res_offsets);
+
+    ASSERT_EQ(res_ids, std::vector<int64_t>({N / 2 - 1, N / 2}));
+    for (auto id : probes) {
+        auto found = std::find(res_ids.begin(), res_ids.end(), id) != res_ids.end();
+        ASSERT_EQ(found, static_cast<bool>(mask[id])) << id;
+    }
+}
+
+TEST(GetEntityByIds, GrowingAtTimestamp) {
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema);
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+    auto growing = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+
+    // row ids and timestamps of DataGen are 0, 1, 2, ..., a row is visible at its own timestamp like in sealed
+    Timestamp query_ts = N / 2;
+    IdArray req_ids;
+    for (auto id : {N / 2 - 1, N / 2, N / 2 + 1}) {
+        req_ids.mutable_int_id()->add_data(id);
+    }
+    auto [res_ids, res_offsets] = growing->search_ids(req_ids, query_ts);
+    auto& res_data = res_ids->int_id().data();
+    ASSERT_EQ(std::vector<int64_t>(res_data.begin(), res_data.end()), std::vector<int64_t>({N / 2 - 1, N / 2}));
+    ASSERT_EQ(growing->get_active_count(query_ts), N / 2 + 1);
+}
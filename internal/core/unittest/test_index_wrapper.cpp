@@ -11,6 +11,7 @@
 
 #include <tuple>
 #include <map>
+#include <cstdio>
 #include <gtest/gtest.h>
 #include <google/protobuf/text_format.h>
 
@@ -412,6 +413,52 @@ TEST_P(IndexWrapperTest, Codec) {
     }
 }
 
+TEST_P(IndexWrapperTest, StreamingSerialize) {
+    auto index =
+        std::make_unique<milvus::indexbuilder::IndexWrapper>(type_params_str.c_str(), index_params_str.c_str());
+    ASSERT_NO_THROW(index->BuildWithoutIds(xb_dataset));
+    auto binary = index->Serialize();
+
+    // wire compatible with the protobuf message
+    indexcgo::BinarySet binary_set;
+    ASSERT_TRUE(binary_set.ParseFromArray(binary->data.data(), binary->data.size()));
+    std::string expected;
+    ASSERT_TRUE(binary_set.SerializeToString(&expected));
+    ASSERT_EQ(std::string(binary->data.data(), binary->data.size()), expected);
+
+    struct ChunkedSink : milvus::indexbuilder::IndexWrapper::BinarySink {
+        void
+        Reserve(size_t total_size) override {
+            reserved = total_size;
+        }
+        void
+        Write(const void* data, size_t size) override {
+            chunks.emplace_back((const char*)data, size);
+        }
+        size_t reserved = 0;
+        std::vector<std::string> chunks;
+    };
+    ChunkedSink sink;
+    index->Serialize(sink);
+    std::string joined;
+    for (auto& chunk : sink.chunks) {
+        joined += chunk;
+    }
+    ASSERT_EQ(sink.reserved, joined.size());
+    if (!milvus::indexbuilder::is_in_nm_list(index_type)) {
+        ASSERT_EQ(joined, expected);
+    } else {
+        ASSERT_EQ(joined.size(), expected.size());
+    }
+
+    auto file = std::tmpfile();
+    auto status = SerializeToFile(index.get(), fileno(file));
+    ASSERT_EQ(status.error_code, Success);
+    std::fseek(file, 0, SEEK_END);
+    ASSERT_EQ(std::ftell(file), (long)expected.size());
+    std::fclose(file);
+}
+
 TEST_P(IndexWrapperTest, Query) {
     auto index_wrapper =
         std::make_unique<milvus::indexbuilder::IndexWrapper>(type_params_str.c_str(), index_params_str.c_str());
@@ -594,6 +594,61 @@ TEST(Query, ExecWithoutPredicate) {
     ASSERT_EQ(json.dump(2), ref.dump(2));
 }
 
+TEST(Query, ExecChunkParallel) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::FLOAT);
+    auto make_dsl = [](int64_t parallelism) {
+        return R"({
+            "bool": {
+                "must": [
+                {
+                    "range": {
+                        "age": {
+                            "GE": -1,
+                            "LT": 1
+                        }
+                    }
+                },
+                {
+                    "vector": {
+                        "fakevec": {
+                            "metric_type": "L2",
+                            "params": {
+                                "nprobe": 10,
+                                "segment_parallelism": )" +
+               std::to_string(parallelism) + R"(
+                            },
+                            "query": "$0",
+                            "topk": 5
+                        }
+                    }
+                }
+                ]
+            }
+        })";
+    };
+    int64_t N = 1000 * 1000;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema);
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroup(num_queries, 16, 1024);
+    Timestamp time = 1000000;
+    auto search = [&](int64_t parallelism) {
+        auto plan = CreatePlan(*schema, make_dsl(parallelism));
+        auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+        return SearchResultToJson(segment->Search(plan.get(), *ph_group, time)).dump(2);
+    };
+    auto ref = search(1);
+    ASSERT_EQ(search(0), ref);
+    ASSERT_EQ(search(3), ref);
+}
+
 TEST(Indexing, InnerProduct) {
     int64_t N = 100000;
     constexpr auto dim = 16;
@@ -743,14 +798,13 @@ TEST(Query, FillSegment) {
         result.result_offsets_.resize(topk * num_queries);
         segment->FillTargetEntry(plan.get(), result);
 
-        auto ans = result.row_data_;
-        ASSERT_EQ(ans.size(), topk * num_queries);
-        int64_t std_index = 0;
+        ASSERT_EQ(result.row_data_sizeof_, sizeof(int64_t) + sizeof(float) * dim + sizeof(int32_t));
+        ASSERT_EQ(result.row_data_.size(), topk * num_queries * result.row_data_sizeof_);
 
-        for (auto& vec : ans) {
-            ASSERT_EQ(vec.size(), sizeof(int64_t) + sizeof(float) * dim + sizeof(int32_t));
+        for (int64_t std_index = 0; std_index < topk * num_queries; ++std_index) {
+            auto row_data = result.get_row_data(std_index);
             int64_t val;
-            memcpy(&val, vec.data(), sizeof(int64_t));
+            memcpy(&val, row_data, sizeof(int64_t));
 
             auto internal_offset = result.internal_seg_offsets_[std_index];
             auto std_val = std_vec[internal_offset];
@@ -762,12 +816,11 @@ TEST(Query, FillSegment) {
             if (val != -1) {
                 std::vector<float> vfloat(dim);
                 int i32;
-                memcpy(vfloat.data(), vec.data() + sizeof(int64_t), dim * sizeof(float));
-                memcpy(&i32, vec.data() + sizeof(int64_t) + dim * sizeof(float), sizeof(int32_t));
+                memcpy(vfloat.data(), row_data + sizeof(int64_t), dim * sizeof(float));
+                memcpy(&i32, row_data + sizeof(int64_t) + dim * sizeof(float), sizeof(int32_t));
                 ASSERT_EQ(vfloat, std_vfloat) << std_index;
                 ASSERT_EQ(i32, std_i32) << std_index;
             }
-            ++std_index;
         }
     }
 }
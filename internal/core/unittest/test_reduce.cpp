@@ -11,8 +11,10 @@
 
 #include <gtest/gtest.h>
 #include "query/SubSearchResult.h"
+#include "segcore/Reduce.h"
 #include <vector>
 #include <queue>
+#include <numeric>
 #include <random>
 
 using namespace milvus;
@@ -117,4 +119,44 @@ TEST(Reduce, SubSearchResultDesc) {
             ASSERT_EQ(value, ref_x);
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(Reduce, MergeTopkInPlace) {
+    std::default_random_engine e(42);
+    for (int iter = 0; iter < 1000; ++iter) {
+        int64_t topk = 1 + e() % 20;
+        std::vector<float> dst_values(topk);
+        std::vector<float> src_values(topk);
+        std::vector<int64_t> dst_labels(topk);
+        std::vector<int64_t> src_labels(topk);
+        for (int64_t i = 0; i < topk; ++i) {
+            // few distinct values to produce many ties
+            dst_values[i] = e() % 8;
+            src_values[i] = e() % 8;
+        }
+        std::sort(dst_values.begin(), dst_values.end());
+        std::sort(src_values.begin(), src_values.end());
+        std::iota(dst_labels.begin(), dst_labels.end(), 0);
+        std::iota(src_labels.begin(), src_labels.end(), topk);
+
+        // reference: plain forward merge, dst goes first on ties
+        std::vector<float> ref_values;
+        std::vector<int64_t> ref_labels;
+        int64_t dst_iter = 0;
+        int64_t src_iter = 0;
+        for (int64_t i = 0; i < topk; ++i) {
+            if (src_values[src_iter] < dst_values[dst_iter]) {
+                ref_values.push_back(src_values[src_iter]);
+                ref_labels.push_back(src_labels[src_iter++]);
+            } else {
+                ref_values.push_back(dst_values[dst_iter]);
+                ref_labels.push_back(dst_labels[dst_iter++]);
+            }
+        }
+
+        segcore::merge_topk_inplace(topk, dst_values.data(), dst_labels.data(), src_values.data(), src_labels.data(),
+                                    [](float src_v, float dst_v) { return src_v < dst_v; });
+        ASSERT_EQ(dst_values, ref_values);
+        ASSERT_EQ(dst_labels, ref_labels);
+    }
+}
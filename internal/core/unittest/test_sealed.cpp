@@ -19,6 +19,9 @@
 #include <knowhere/index/vector_index/VecIndexFactory.h>
 #include <knowhere/index/vector_index/IndexIVF.h>
 #include "segcore/SegmentSealedImpl.h"
+#include "segcore/segment_c.h"
+#include <cstdio>
+#include <unistd.h>
 
 using namespace milvus;
 using namespace milvus::segcore;
@@ -340,3 +343,199 @@ TEST(Sealed, LoadFieldData) {
 ])");
     ASSERT_EQ(std_json.dump(-2), json.dump(-2));
 }
+
+TEST(Sealed, LoadFieldDataWithoutCopy) {
+    auto dim = 16;
+    int64_t N = 1000;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+
+    // hand over the blobs, the segment keeps views and releases them on drop
+    int released = 0;
+    auto load_view = [&](int64_t field_id, const void* blob) {
+        LoadFieldDataInfo info;
+        info.field_id = field_id;
+        info.blob = blob;
+        info.row_count = N;
+        info.release = [&released] { ++released; };
+        segment->LoadFieldData(info);
+    };
+    load_view(0, dataset.row_ids_.data());
+    load_view(1, dataset.timestamps_.data());
+    load_view(fakevec_id.get(), dataset.cols_[0].data());
+    ASSERT_EQ(segment->chunk_data<float>(FieldOffset(0), 0).data(), (const float*)dataset.cols_[0].data());
+
+    // load counter from a mmapped column file
+    char path[] = "/tmp/milvus_sealed_column_XXXXXX";
+    auto fd = mkstemp(path);
+    ASSERT_NE(fd, -1);
+    auto& col = dataset.cols_[1];
+    ASSERT_EQ(write(fd, col.data(), col.size()), (ssize_t)col.size());
+    close(fd);
+    auto c_segment = static_cast<CSegmentInterface>(segment.get());
+    auto status = LoadFieldDataFromFile(c_segment, counter_id.get(), path, N + 1);
+    ASSERT_NE(status.error_code, Success);
+    free((char*)status.error_msg);
+    status = LoadFieldDataFromFile(c_segment, counter_id.get(), path, N);
+    ASSERT_EQ(status.error_code, Success) << status.error_msg;
+    unlink(path);
+
+    auto span = segment->chunk_data<int64_t>(FieldOffset(1), 0);
+    auto ref = dataset.get_col<int64_t>(1);
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(span[i], ref[i]);
+    }
+    ASSERT_EQ(segment->get_row_count(), N);
+
+    ASSERT_EQ(released, 0);
+    segment->DropFieldData(fakevec_id);
+    ASSERT_EQ(released, 1);
+    segment->DropFieldData(counter_id);
+    segment.reset();
+    ASSERT_EQ(released, 3);
+}
+
+TEST(Sealed, LoadFieldDataWithRelease) {
+    auto dim = 16;
+    int64_t N = 1000;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    auto c_segment = static_cast<CSegmentInterface>(segment.get());
+
+    int released = 0;
+    auto release = [](void* arg) { ++*static_cast<int*>(arg); };
+    auto& col = dataset.cols_[1];
+    CLoadFieldDataInfo info{counter_id.get(), col.data(), 0};
+    // a failed load releases the blob as well
+    auto status = LoadFieldDataWithRelease(c_segment, info, release, &released);
+    ASSERT_NE(status.error_code, Success);
+    free((char*)status.error_msg);
+    ASSERT_EQ(released, 1);
+
+    info.row_count = N;
+    status = LoadFieldDataWithRelease(c_segment, info, release, &released);
+    ASSERT_EQ(status.error_code, Success) << status.error_msg;
+    ASSERT_EQ(segment->chunk_data<int64_t>(FieldOffset(1), 0).data(), (const int64_t*)col.data());
+    ASSERT_EQ(released, 1);
+    segment->DropFieldData(counter_id);
+    ASSERT_EQ(released, 2);
+}
+
+TEST(Sealed, LoadSegment) {
+    auto dim = 16;
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    auto double_id = schema->AddDebugField("double", DataType::DOUBLE);
+    auto dataset = DataGen(schema, N);
+
+    std::vector<LoadFieldDataInfo> infos;
+    infos.push_back(LoadFieldDataInfo{0, dataset.row_ids_.data(), N});
+    infos.push_back(LoadFieldDataInfo{1, dataset.timestamps_.data(), N});
+    for (int i = 0; i < 3; ++i) {
+        auto field_id = schema->get_fields()[i].get_id().get();
+        infos.push_back(LoadFieldDataInfo{field_id, dataset.cols_[i].data(), N});
+    }
+
+    // a broken batch loads nothing
+    auto segment = CreateSealedSegment(schema);
+    auto broken = infos;
+    broken.back().row_count = N - 1;
+    ASSERT_ANY_THROW(segment->LoadSegment(broken));
+    broken = infos;
+    broken.push_back(infos.back());
+    ASSERT_ANY_THROW(segment->LoadSegment(broken));
+    ASSERT_EQ(segment->get_row_count(), 0);
+    ASSERT_FALSE(segment->HasFieldData(fakevec_id));
+
+    segment->LoadSegment(infos);
+    ASSERT_EQ(segment->get_row_count(), N);
+    ASSERT_TRUE(segment->HasFieldData(fakevec_id));
+    ASSERT_TRUE(segment->HasFieldData(double_id));
+    auto span1 = segment->chunk_data<int64_t>(FieldOffset(1), 0);
+    auto span2 = segment->chunk_data<double>(FieldOffset(2), 0);
+    auto ref1 = dataset.get_col<int64_t>(1);
+    auto ref2 = dataset.get_col<double>(2);
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(span1[i], ref1[i]);
+        ASSERT_EQ(span2[i], ref2[i]);
+    }
+    ASSERT_ANY_THROW(segment->LoadSegment({infos[2]}));
+
+    segment->DropFieldData(counter_id);
+    ASSERT_FALSE(segment->HasFieldData(counter_id));
+    segment->LoadSegment({infos[3]});
+    ASSERT_TRUE(segment->HasFieldData(counter_id));
+}
+
+TEST(Sealed, MaskWithTimestamps) {
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoader(dataset, *segment);
+
+    // timestamps of DataGen are 0, 1, 2, ...
+    for (int round = 0; round < 2; ++round) {
+        boost::dynamic_bitset<> bitset;
+        segment->mask_with_timestamps(bitset, N / 2);
+        ASSERT_EQ(bitset.size(), N);
+        ASSERT_EQ(bitset.count(), N / 2 + 1);
+
+        boost::dynamic_bitset<> predicate(N);
+        predicate.set(0);
+        predicate.set(N - 1);
+        segment->mask_with_timestamps(predicate, N / 2);
+        ASSERT_EQ(predicate.count(), 1);
+    }
+
+    // nothing to mask if all rows are visible
+    boost::dynamic_bitset<> bitset;
+    segment->mask_with_timestamps(bitset, N);
+    ASSERT_TRUE(bitset.empty());
+}
+
+TEST(Sealed, MemoryUsage) {
+    auto dim = 16;
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_key(FieldOffset(1));
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    ASSERT_EQ(segment->GetMemoryUsageInBytes(), 0);
+
+    SealedLoader(dataset, *segment);
+    auto usage = segment->GetMemoryUsage();
+    ASSERT_EQ(usage.field_data, N * (dim * sizeof(float) + sizeof(int64_t)));
+    ASSERT_EQ(usage.system_field_data, N * (sizeof(int64_t) + sizeof(Timestamp)));
+    ASSERT_EQ(usage.scalar_index, N * sizeof(knowhere::scalar::IndexStructure<int64_t>));
+    ASSERT_GE(usage.primary_key_index, N * (sizeof(int64_t) * 2));
+    ASSERT_GT(usage.timestamp_index, 0);
+    ASSERT_EQ(usage.vector_index, 0);
+    ASSERT_EQ(usage.cache, 0);
+
+    // cached timestamp masks are accounted too
+    boost::dynamic_bitset<> bitset;
+    segment->mask_with_timestamps(bitset, N / 2);
+    ASSERT_EQ(segment->GetMemoryUsage().cache, upper_div(N, 64) * sizeof(uint64_t));
+
+    LoadIndexInfo load_info;
+    load_info.field_id = fakevec_id.get();
+    load_info.index = GenIndexing(N, dim, dataset.get_col<float>(0).data());
+    load_info.index_params["metric_type"] = "L2";
+    segment->LoadIndex(load_info);
+    usage = segment->GetMemoryUsage();
+    ASSERT_GT(usage.vector_index, N * dim * sizeof(float));
+    ASSERT_EQ(segment->GetMemoryUsageInBytes(), usage.total());
+}
@@ -18,8 +18,11 @@
 // #include "segment/SegmentReader.h"
 // #include "segment/SegmentWriter.h"
 #include "segcore/SegmentGrowing.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "segcore/IndexingExecutor.h"
 // #include "utils/Json.h"
 #include "test_utils/DataGen.h"
+#include <future>
 #include <random>
 #include <optional>
 using std::cin;
@@ -121,3 +124,89 @@ TEST(SegmentCoreTest, SmallIndex) {
     int N = 1024 * 1024;
     auto data = DataGen(schema, N);
 }
+
+TEST(SegmentCoreTest, BackgroundSmallIndex) {
+    using namespace milvus::segcore;
+    using namespace milvus::engine;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::INT32);
+
+    // restore the synchronous executor even if an assertion fails
+    struct ExecutorGuard {
+        ~ExecutorGuard() {
+            IndexingExecutor::GetInstance().SetThreadNum(0);
+        }
+    } executor_guard;
+    auto& executor = IndexingExecutor::GetInstance();
+    executor.SetThreadNum(1);
+
+    auto segment = CreateGrowingSegment(schema);
+    // declared after the segment, so it is released before the segment waits for its builds
+    std::promise<void> gate;
+    std::shared_future<void> gate_future = gate.get_future();
+    // keep the only worker busy, so no build can finish before the gate opens
+    executor.Submit([gate_future] { gate_future.wait(); });
+
+    auto size_per_chunk = SegcoreConfig::default_config().get_size_per_chunk();
+    int64_t N = size_per_chunk * 3 + 1;
+    auto dataset = DataGen(schema, N);
+    segment->PreInsert(N);
+    // returns with all builds still queued
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    auto& indexing_record = dynamic_cast<SegmentGrowingImpl*>(segment.get())->get_indexing_record();
+    auto& vec_indexing = indexing_record.get_vec_field_indexing(FieldOffset(0));
+    ASSERT_EQ(indexing_record.get_finished_ack(), 0);
+    ASSERT_EQ(vec_indexing.get_chunk_indexing(0), nullptr);
+
+    gate.set_value();
+    indexing_record.WaitForPendingBuilds();
+    ASSERT_EQ(indexing_record.get_finished_ack(), 3);
+    for (int chunk_id = 0; chunk_id < 3; ++chunk_id) {
+        ASSERT_NE(vec_indexing.get_chunk_indexing(chunk_id), nullptr);
+    }
+
+    // release with builds in flight
+    auto segment2 = CreateGrowingSegment(schema);
+    segment2->PreInsert(N);
+    segment2->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+    segment2.reset();
+}
+
+TEST(SegmentCoreTest, VersionedDeleteBitmap) {
+    using namespace milvus::segcore;
+    using namespace milvus::engine;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::INT32);
+    int64_t N = DeletedRecord::bitmap_size_per_chunk * 3;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema);
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    // row ids and timestamps of DataGen are both 0, 1, 2, ...
+    std::vector<int64_t> del_uids{3, 5, N - 1};
+    std::vector<Timestamp> del_timestamps(del_uids.size(), N);
+    auto del_offset = segment->PreDelete(del_uids.size());
+    segment->Delete(del_offset, del_uids.size(), del_uids.data(), del_timestamps.data());
+
+    auto growing = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+    auto v1 = growing->get_deleted_bitmap(2, N, N);
+    ASSERT_TRUE(v1->test(3));
+    ASSERT_TRUE(v1->test(5));
+    ASSERT_FALSE(v1->test(4));
+    ASSERT_FALSE(v1->test(N - 1));
+    // the same barrier gets the cached version
+    ASSERT_EQ(growing->get_deleted_bitmap(2, N, N), v1);
+
+    auto v2 = growing->get_deleted_bitmap(3, N, N);
+    ASSERT_TRUE(v2->test(3));
+    ASSERT_TRUE(v2->test(N - 1));
+    // untouched chunks are shared between versions
+    ASSERT_EQ(v1->chunks[0], v2->chunks[0]);
+    ASSERT_EQ(v1->chunks[1], nullptr);
+    ASSERT_NE(v1->chunks[2], v2->chunks[2]);
+    ASSERT_FALSE(v1->test(N - 1));
+}
@@ -34,3 +34,26 @@ TEST(TimestampIndex, Naive) {
         ASSERT_EQ(guessed_slice[i], lengths[i]);
     }
 }
+
+TEST(TimestampIndex, GenerateBitset) {
+    std::default_random_engine e(42);
+    int64_t size = 1000;
+    std::vector<Timestamp> timestamps(size);
+    for (auto& ts : timestamps) {
+        ts = e() % 100;
+    }
+    for (int64_t beg : {0, 1, 63, 64, 65, 500}) {
+        for (int64_t end : {beg, beg + 1, beg + 63, beg + 64, int64_t(999), size}) {
+            if (end > size) {
+                continue;
+            }
+            Timestamp query_ts = e() % 100;
+            auto bitset = TimestampIndex::GenerateBitset(query_ts, {beg, end}, timestamps.data(), size);
+            ASSERT_EQ(bitset.size(), size);
+            for (int64_t i = 0; i < size; ++i) {
+                auto expected = i < beg || (i < end && timestamps[i] <= query_ts);
+                ASSERT_EQ(bitset[i], expected) << beg << " " << end << " " << i;
+            }
+        }
+    }
+}
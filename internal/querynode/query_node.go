@@ -27,6 +27,7 @@ import "C"
 import (
 	"context"
 	"errors"
+	"runtime"
 	"strconv"
 	"sync/atomic"
 
@@ -124,6 +125,8 @@ func (node *QueryNode) Init() error {
 	node.streaming = newStreaming(node.queryNodeLoopCtx, node.msFactory, node.etcdKV)
 
 	C.SegcoreInit()
+	// build small indexes of growing segments off the insert path
+	C.SegcoreSetIndexBuildThreadNum(C.int64_t((runtime.NumCPU() + 1) / 2))
 
 	if node.rootCoord == nil {
 		log.Error("null root coordinator detected")
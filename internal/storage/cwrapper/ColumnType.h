@@ -24,6 +24,15 @@ enum ColumnType : int {
   VECTOR_FLOAT = 101
 };
 
+// COMPRESSION_AUTO picks the codec of a payload from a sample of its values.
+// writers default to COMPRESSION_NONE, binaries built without the codecs can't read compressed payloads
+enum CompressionType : int {
+  COMPRESSION_AUTO = 0,
+  COMPRESSION_NONE = 1,
+  COMPRESSION_LZ4 = 2,
+  COMPRESSION_ZSTD = 3
+};
+
 enum ErrorCode : int {
   SUCCESS = 0,
   UNEXPECTED_ERROR = 1,
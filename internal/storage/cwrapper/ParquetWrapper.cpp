@@ -11,6 +11,23 @@
 
 #include "ParquetWrapper.h"
 #include "PayloadStream.h"
+#include <algorithm>
+#include <string_view>
+#include <unordered_set>
+#include <arrow/array/concatenate.h>
+#include <arrow/util/compression.h>
+#include <parquet/properties.h>
+
+// the row group length of a payload written as a single row group
+static constexpr int64_t kSingleRowGroupLength = 1024 * 1024 * 1024;
+static constexpr uintptr_t kValuesAlignment = 64;
+// the encoding and compression of a payload are picked from a sample of its values
+static constexpr int64_t kSampleRows = 4096;
+static constexpr int64_t kSampleBytes = 256 * 1024;
+// dictionary encode when the sample has at most 1 / kDictionaryRatio distinct values
+static constexpr int64_t kDictionaryRatio = 8;
+// don't compress when the codec saves less than this fraction of the sample
+static constexpr double kMinCompressionSaving = 0.1;
 
 static const char *ErrorMsg(const std::string &msg) {
   if (msg.empty()) return nullptr;
@@ -28,6 +45,9 @@ CPayloadWriter NewPayloadWriter(int columnType) {
   p->output = nullptr;
   p->dimension = wrapper::EMPTY_DIMENSION;
   p->rows = 0;
+  // compressed payloads are unreadable by binaries built without the codecs, so compression is opt-in
+  p->compression = CompressionType::COMPRESSION_NONE;
+  p->autoEncoding = true;
   switch (static_cast<ColumnType>(columnType)) {
     case ColumnType::BOOL : {
       p->columnType = ColumnType::BOOL;
@@ -286,6 +306,142 @@ CStatus AddFloatVectorToPayload(CPayloadWriter payloadWriter, float *values, int
   return st;
 }
 
+static arrow::Compression::type ArrowCompressionOf(CompressionType compression) {
+  switch (compression) {
+    case CompressionType::COMPRESSION_LZ4: return arrow::Compression::LZ4;
+    case CompressionType::COMPRESSION_ZSTD: return arrow::Compression::ZSTD;
+    default: return arrow::Compression::UNCOMPRESSED;
+  }
+}
+
+extern "C"
+CStatus SetPayloadWriterOptions(CPayloadWriter payloadWriter, int compression, bool autoEncoding) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto p = reinterpret_cast<wrapper::PayloadWriter *>(payloadWriter);
+  if (p->output != nullptr) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("payload writer is already finished");
+    return st;
+  }
+  auto type = static_cast<CompressionType>(compression);
+  switch (type) {
+    case CompressionType::COMPRESSION_AUTO:
+    case CompressionType::COMPRESSION_NONE: break;
+    case CompressionType::COMPRESSION_LZ4:
+    case CompressionType::COMPRESSION_ZSTD: {
+      if (!arrow::util::Codec::IsAvailable(ArrowCompressionOf(type))) {
+        st.error_code = static_cast<int>(ErrorCode::ILLEGAL_ARGUMENT);
+        st.error_msg = ErrorMsg("compression codec is not built in");
+        return st;
+      }
+      break;
+    }
+    default: {
+      st.error_code = static_cast<int>(ErrorCode::ILLEGAL_ARGUMENT);
+      st.error_msg = ErrorMsg("unknown compression type");
+      return st;
+    }
+  }
+  p->compression = type;
+  p->autoEncoding = autoEncoding;
+  return st;
+}
+
+// the buffer holding the values of the array, the validity bitmap and string offsets are left out
+static const std::shared_ptr<arrow::Buffer> &ValuesBuffer(ColumnType columnType, const arrow::Array &array) {
+  return array.data()->buffers[columnType == ColumnType::STRING ? 2 : 1];
+}
+
+static bool IsLowCardinality(ColumnType columnType, const arrow::Array &array) {
+  auto rows = std::min(array.length(), kSampleRows);
+  if (rows == 0) return false;
+  std::unordered_set<uint64_t> distinct;
+  if (columnType == ColumnType::STRING) {
+    auto &strings = static_cast<const arrow::StringArray &>(array);
+    for (int64_t i = 0; i < rows; i++) {
+      auto view = strings.GetView(i);
+      distinct.insert(std::hash<std::string_view>()(std::string_view(view.data(), view.size())));
+    }
+  } else {
+    auto width = static_cast<const arrow::FixedWidthType &>(*array.type()).bit_width() / 8;
+    auto values = array.data()->GetValues<uint8_t>(1, 0) + array.offset() * width;
+    for (int64_t i = 0; i < rows; i++) {
+      uint64_t value = 0;
+      std::memcpy(&value, values + i * width, width);
+      distinct.insert(value);
+    }
+  }
+  return static_cast<int64_t>(distinct.size()) * kDictionaryRatio <= rows;
+}
+
+// fraction of the sample left after compression, 1 if it can't be compressed
+static double SampleCompressionRatio(arrow::Compression::type codec, const arrow::Buffer &values) {
+  auto length = std::min(values.size(), kSampleBytes);
+  if (length == 0) return 1;
+  auto rst = arrow::util::Codec::Create(codec);
+  if (!rst.ok()) return 1;
+  auto &compressor = *rst;
+  std::vector<uint8_t> out(compressor->MaxCompressedLen(length, values.data()));
+  auto size = compressor->Compress(length, values.data(), out.size(), out.data());
+  if (!size.ok()) return 1;
+  return static_cast<double>(*size) / length;
+}
+
+// dictionary encoding for low cardinality columns, byte stream split for other floats and doubles
+// when they are compressed. vectors are decoded on every segment load and take lz4, scalars take zstd,
+// and compression is skipped when a sample of the values doesn't shrink.
+static std::shared_ptr<parquet::WriterProperties> PayloadWriterProperties(const wrapper::PayloadWriter &p,
+                                                                          const arrow::Array &array) {
+  parquet::WriterProperties::Builder builder;
+  bool byteStreamSplit = false;
+  if (p.autoEncoding) {
+    switch (p.columnType) {
+      case ColumnType::BOOL:
+      case ColumnType::VECTOR_BINARY:
+      case ColumnType::VECTOR_FLOAT: {
+        builder.disable_dictionary();
+        break;
+      }
+      case ColumnType::FLOAT:
+      case ColumnType::DOUBLE: {
+        if (!IsLowCardinality(p.columnType, array)) {
+          builder.disable_dictionary();
+          byteStreamSplit = true;
+        }
+        break;
+      }
+      default: {
+        if (!IsLowCardinality(p.columnType, array)) builder.disable_dictionary();
+        break;
+      }
+    }
+  }
+
+  auto compression = p.compression;
+  if (compression == CompressionType::COMPRESSION_AUTO) {
+    bool isVector = p.columnType == ColumnType::VECTOR_BINARY || p.columnType == ColumnType::VECTOR_FLOAT;
+    compression = isVector ? CompressionType::COMPRESSION_LZ4 : CompressionType::COMPRESSION_ZSTD;
+    auto codec = ArrowCompressionOf(compression);
+    if (!arrow::util::Codec::IsAvailable(codec)) {
+      compression = CompressionType::COMPRESSION_NONE;
+    } else if (!byteStreamSplit) {
+      // byte stream split is there for the codec, so split floats are always compressed
+      auto &values = ValuesBuffer(p.columnType, array);
+      if (values == nullptr || SampleCompressionRatio(codec, *values) > 1 - kMinCompressionSaving) {
+        compression = CompressionType::COMPRESSION_NONE;
+      }
+    }
+  }
+  // byte stream split only groups the bytes for the codec, uncompressed it just costs time
+  if (byteStreamSplit && compression != CompressionType::COMPRESSION_NONE) {
+    builder.encoding(parquet::Encoding::BYTE_STREAM_SPLIT);
+  }
+  builder.compression(ArrowCompressionOf(compression));
+  return builder.build();
+}
+
 extern "C"
 CStatus FinishPayloadWriter(CPayloadWriter payloadWriter) {
   CStatus st;
@@ -307,7 +463,11 @@ CStatus FinishPayloadWriter(CPayloadWriter payloadWriter) {
     }
     auto table = arrow::Table::Make(p->schema, {array});
     p->output = std::make_shared<wrapper::PayloadOutputStream>();
-    ast = parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), p->output, 1024 * 1024 * 1024);
+    ast = parquet::arrow::WriteTable(*table,
+                                     arrow::default_memory_pool(),
+                                     p->output,
+                                     kSingleRowGroupLength,
+                                     PayloadWriterProperties(*p, *array));
     if (!ast.ok()) {
       st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
       st.error_msg = ErrorMsg(ast.message());
@@ -347,6 +507,12 @@ CStatus ReleasePayloadWriter(CPayloadWriter handler) {
   return st;
 }
 
+// a column has one chunk per row group
+static arrow::Result<std::shared_ptr<arrow::Array>> ColumnArray(const std::shared_ptr<arrow::ChunkedArray> &column) {
+  if (column->num_chunks() == 1) return column->chunk(0);
+  return arrow::Concatenate(column->chunks(), arrow::default_memory_pool());
+}
+
 extern "C"
 CPayloadReader NewPayloadReader(int columnType, uint8_t *buffer, int64_t buf_size) {
   auto p = new wrapper::PayloadReader;
@@ -364,8 +530,12 @@ CPayloadReader NewPayloadReader(int columnType, uint8_t *buffer, int64_t buf_siz
   }
   p->column = p->table->column(0);
   assert(p->column != nullptr);
-  assert(p->column->chunks().size() == 1);
-  p->array = p->column->chunk(0);
+  auto array = ColumnArray(p->column);
+  if (!array.ok()) {
+    delete p;
+    return nullptr;
+  }
+  p->array = *array;
 
   switch (columnType) {
     case ColumnType::BOOL :
@@ -385,6 +555,7 @@ CPayloadReader NewPayloadReader(int columnType, uint8_t *buffer, int64_t buf_siz
       return nullptr;
     }
   }
+  p->column_type = static_cast<ColumnType>(columnType);
   return reinterpret_cast<CPayloadReader>(p);
 }
 
@@ -535,3 +706,135 @@ CStatus ReleasePayloadReader(CPayloadReader payloadReader) {
   delete p;
   return st;
 }
+
+static arrow::Type::type ArrowTypeOf(ColumnType column_type) {
+  switch (column_type) {
+    case ColumnType::BOOL : return arrow::Type::BOOL;
+    case ColumnType::INT8 : return arrow::Type::INT8;
+    case ColumnType::INT16 : return arrow::Type::INT16;
+    case ColumnType::INT32 : return arrow::Type::INT32;
+    case ColumnType::INT64 : return arrow::Type::INT64;
+    case ColumnType::FLOAT : return arrow::Type::FLOAT;
+    case ColumnType::DOUBLE : return arrow::Type::DOUBLE;
+    case ColumnType::STRING : return arrow::Type::STRING;
+    default: return arrow::Type::FIXED_SIZE_BINARY;
+  }
+}
+
+// point values at the arrow buffer if it is aligned, bools are unpacked from bits into bytes
+static arrow::Status SetChunkValues(wrapper::PayloadChunk *chunk) {
+  auto &array = chunk->array;
+  if (array->type_id() != ArrowTypeOf(chunk->column_type)) {
+    return arrow::Status::TypeError("incorrect data type");
+  }
+  chunk->values = nullptr;
+  chunk->dimension = 1;
+  if (chunk->column_type == ColumnType::STRING || array->length() == 0) {
+    return arrow::Status::OK();
+  }
+
+  if (chunk->column_type == ColumnType::BOOL) {
+    auto bool_array = std::static_pointer_cast<arrow::BooleanArray>(array);
+    ARROW_ASSIGN_OR_RAISE(chunk->values_buffer, arrow::AllocateBuffer(bool_array->length()));
+    auto out = reinterpret_cast<bool *>(chunk->values_buffer->mutable_data());
+    for (int64_t i = 0; i < bool_array->length(); i++) {
+      out[i] = bool_array->Value(i);
+    }
+    chunk->values = chunk->values_buffer->data();
+    return arrow::Status::OK();
+  }
+
+  int byte_width = std::static_pointer_cast<arrow::FixedWidthType>(array->type())->bit_width() / 8;
+  if (chunk->column_type == ColumnType::VECTOR_BINARY) {
+    chunk->dimension = byte_width * 8;
+  } else if (chunk->column_type == ColumnType::VECTOR_FLOAT) {
+    chunk->dimension = byte_width / sizeof(float);
+  }
+  auto &data = array->data();
+  auto values = data->buffers[1]->data() + data->offset * byte_width;
+  if (reinterpret_cast<uintptr_t>(values) % kValuesAlignment == 0) {
+    chunk->values = values;
+    return arrow::Status::OK();
+  }
+  auto size = array->length() * byte_width;
+  ARROW_ASSIGN_OR_RAISE(chunk->values_buffer, arrow::AllocateBuffer(size));
+  std::memcpy(chunk->values_buffer->mutable_data(), values, size);
+  chunk->values = chunk->values_buffer->data();
+  return arrow::Status::OK();
+}
+
+extern "C"
+CStatus GetChunkFromPayload(CPayloadReader payloadReader, CPayloadChunk *chunk) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  *chunk = nullptr;
+  auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  auto c = std::make_unique<wrapper::PayloadChunk>();
+  c->column_type = p->column_type;
+  c->array = p->array;
+  auto ast = SetChunkValues(c.get());
+  if (!ast.ok()) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg(ast.message());
+    return st;
+  }
+  *chunk = reinterpret_cast<CPayloadChunk>(c.release());
+  return st;
+}
+
+extern "C"
+CStatus GetValuesFromPayloadChunk(CPayloadChunk chunk, void **values, int *dimension, int *length) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto c = reinterpret_cast<wrapper::PayloadChunk *>(chunk);
+  if (c->column_type == ColumnType::STRING) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("incorrect data type");
+    return st;
+  }
+  *values = (void *) c->values;
+  *dimension = c->dimension;
+  *length = c->array->length();
+  return st;
+}
+
+extern "C"
+CStatus GetOneStringFromPayloadChunk(CPayloadChunk chunk, int idx, char **cstr, int *str_size) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto c = reinterpret_cast<wrapper::PayloadChunk *>(chunk);
+  auto array = std::dynamic_pointer_cast<arrow::StringArray>(c->array);
+  if (array == nullptr) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("Incorrect data type");
+    return st;
+  }
+  if (idx >= array->length()) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("memory overflow");
+    return st;
+  }
+  arrow::StringArray::offset_type length;
+  *cstr = (char *) array->GetValue(idx, &length);
+  *str_size = length;
+  return st;
+}
+
+extern "C"
+int GetPayloadLengthFromChunk(CPayloadChunk chunk) {
+  auto c = reinterpret_cast<wrapper::PayloadChunk *>(chunk);
+  return c->array->length();
+}
+
+extern "C"
+CStatus ReleasePayloadChunk(CPayloadChunk chunk) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto c = reinterpret_cast<wrapper::PayloadChunk *>(chunk);
+  delete c;
+  return st;
+}
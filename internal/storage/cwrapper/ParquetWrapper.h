@@ -42,6 +42,10 @@ CStatus AddOneStringToPayload(CPayloadWriter payloadWriter, char *cstr, int str_
 CStatus AddBinaryVectorToPayload(CPayloadWriter payloadWriter, uint8_t *values, int dimension, int length);
 CStatus AddFloatVectorToPayload(CPayloadWriter payloadWriter, float *values, int dimension, int length);
 
+// must be called before FinishPayloadWriter, compression is one of CompressionType.
+// the default is COMPRESSION_NONE, only enable compression once every reader is built with lz4 and zstd
+CStatus SetPayloadWriterOptions(CPayloadWriter payloadWriter, int compression, bool autoEncoding);
+
 CStatus FinishPayloadWriter(CPayloadWriter payloadWriter);
 CBuffer GetPayloadBufferFromWriter(CPayloadWriter payloadWriter);
 int GetPayloadLengthFromWriter(CPayloadWriter payloadWriter);
@@ -64,6 +68,19 @@ CStatus GetFloatVectorFromPayload(CPayloadReader payloadReader, float **values,
 int GetPayloadLengthFromReader(CPayloadReader payloadReader);
 CStatus ReleasePayloadReader(CPayloadReader payloadReader);
 
+//============= payload chunk ======================
+// the decoded values of a payload reader handed out without another copy,
+// a chunk shares them with the reader and stays valid after the reader is released
+typedef void *CPayloadChunk;
+CStatus GetChunkFromPayload(CPayloadReader payloadReader, CPayloadChunk *chunk);
+
+// values of a fixed width column, 64 bytes aligned, bool values take one byte each,
+// dimension is 1 for scalar columns
+CStatus GetValuesFromPayloadChunk(CPayloadChunk chunk, void **values, int *dimension, int *length);
+CStatus GetOneStringFromPayloadChunk(CPayloadChunk chunk, int idx, char **cstr, int *str_size);
+int GetPayloadLengthFromChunk(CPayloadChunk chunk);
+CStatus ReleasePayloadChunk(CPayloadChunk chunk);
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,8 @@ struct PayloadWriter {
   std::shared_ptr<arrow::Schema> schema;
   std::shared_ptr<PayloadOutputStream> output;
   int rows;
+  CompressionType compression;
+  bool autoEncoding; // pick dictionary or byte stream split encoding from the values
 };
 
 struct PayloadReader {
@@ -43,6 +45,16 @@ struct PayloadReader {
   bool *bValues;
 };
 
+// the decoded values of a payload, shared with the reader
+struct PayloadChunk {
+  ColumnType column_type;
+  std::shared_ptr<arrow::Array> array;
+  // points into array if its layout matches, otherwise into values_buffer
+  const uint8_t *values;
+  std::shared_ptr<arrow::Buffer> values_buffer;
+  int dimension;
+};
+
 class PayloadOutputStream : public arrow::io::OutputStream {
  public:
   PayloadOutputStream();
@@ -0,0 +1,195 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// write throughput, payload size and decode throughput of the binlog payload
+// for every compression and encoding policy, over the typical columns of a segment
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include <arrow/util/compression.h>
+#include "ParquetWrapper.h"
+#include "ColumnType.h"
+
+namespace {
+
+constexpr int kRows = 1 << 20;
+constexpr int kVectorRows = 1 << 17;
+constexpr int kRepeat = 3;
+
+struct Column {
+  std::string name;
+  ColumnType type;
+  std::vector<uint8_t> values;
+  int dimension; // of vectors, in elements of the add function
+  int rows;
+};
+
+struct Policy {
+  std::string name;
+  CompressionType compression;
+  bool autoEncoding;
+};
+
+std::vector<Column> MakeColumns() {
+  std::mt19937_64 rng(42);
+  std::vector<Column> columns;
+  auto make = [&](std::string name, ColumnType type, size_t width, int dimension, int rows) -> Column & {
+    columns.push_back({std::move(name), type, std::vector<uint8_t>(width * rows), dimension, rows});
+    return columns.back();
+  };
+
+  auto &row_ids = make("row_id", ColumnType::INT64, sizeof(int64_t), 1, kRows);
+  auto ids = reinterpret_cast<int64_t *>(row_ids.values.data());
+  for (int i = 0; i < kRows; i++) ids[i] = 400000000000000000LL + i;
+
+  // an insert batch shares one timestamp
+  auto &timestamps = make("timestamp", ColumnType::INT64, sizeof(int64_t), 1, kRows);
+  auto ts = reinterpret_cast<int64_t *>(timestamps.values.data());
+  for (int i = 0; i < kRows; i++) ts[i] = 423000000000000000LL + (i / 4096) * 262144;
+
+  auto &labels = make("label", ColumnType::INT32, sizeof(int32_t), 1, kRows);
+  auto lb = reinterpret_cast<int32_t *>(labels.values.data());
+  for (int i = 0; i < kRows; i++) lb[i] = static_cast<int32_t>(rng() % 16);
+
+  auto &prices = make("price", ColumnType::DOUBLE, sizeof(double), 1, kRows);
+  auto pr = reinterpret_cast<double *>(prices.values.data());
+  std::normal_distribution<double> normal(100, 15);
+  for (int i = 0; i < kRows; i++) pr[i] = normal(rng);
+
+  auto &embeddings = make("float_vector", ColumnType::VECTOR_FLOAT, 128 * sizeof(float), 128, kVectorRows);
+  auto emb = reinterpret_cast<float *>(embeddings.values.data());
+  std::normal_distribution<float> unit(0, 1);
+  for (size_t i = 0; i < embeddings.values.size() / sizeof(float); i++) emb[i] = unit(rng);
+
+  auto &hashes = make("binary_vector", ColumnType::VECTOR_BINARY, 512 / 8, 512, kVectorRows);
+  for (auto &b : hashes.values) b = static_cast<uint8_t>(rng());
+  return columns;
+}
+
+CStatus AddColumn(CPayloadWriter writer, Column &column) {
+  switch (column.type) {
+    case ColumnType::INT32:
+      return AddInt32ToPayload(writer, reinterpret_cast<int32_t *>(column.values.data()), column.rows);
+    case ColumnType::INT64:
+      return AddInt64ToPayload(writer, reinterpret_cast<int64_t *>(column.values.data()), column.rows);
+    case ColumnType::DOUBLE:
+      return AddDoubleToPayload(writer, reinterpret_cast<double *>(column.values.data()), column.rows);
+    case ColumnType::VECTOR_FLOAT:
+      return AddFloatVectorToPayload(writer,
+                                     reinterpret_cast<float *>(column.values.data()),
+                                     column.dimension,
+                                     column.rows);
+    default:
+      return AddBinaryVectorToPayload(writer, column.values.data(), column.dimension, column.rows);
+  }
+}
+
+// returns the decoded values
+std::pair<const void *, CStatus> ReadColumn(CPayloadReader reader, const Column &column) {
+  void *values = nullptr;
+  int length;
+  int dim;
+  CStatus st;
+  switch (column.type) {
+    case ColumnType::INT32:
+      st = GetInt32FromPayload(reader, reinterpret_cast<int32_t **>(&values), &length);
+      break;
+    case ColumnType::INT64:
+      st = GetInt64FromPayload(reader, reinterpret_cast<int64_t **>(&values), &length);
+      break;
+    case ColumnType::DOUBLE:
+      st = GetDoubleFromPayload(reader, reinterpret_cast<double **>(&values), &length);
+      break;
+    case ColumnType::VECTOR_FLOAT:
+      st = GetFloatVectorFromPayload(reader, reinterpret_cast<float **>(&values), &dim, &length);
+      break;
+    default:
+      st = GetBinaryVectorFromPayload(reader, reinterpret_cast<uint8_t **>(&values), &dim, &length);
+      break;
+  }
+  return {values, st};
+}
+
+double Seconds(std::function<void()> fn) {
+  auto best = std::chrono::duration<double>::max();
+  for (int i = 0; i < kRepeat; i++) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start));
+  }
+  return best.count();
+}
+
+}  // namespace
+
+TEST(wrapper_benchmark, writer_policies) {
+  std::vector<Policy> policies = {{"plain", CompressionType::COMPRESSION_NONE, false},
+                                  {"encoded", CompressionType::COMPRESSION_NONE, true},
+                                  {"lz4", CompressionType::COMPRESSION_LZ4, true},
+                                  {"zstd", CompressionType::COMPRESSION_ZSTD, true},
+                                  {"auto", CompressionType::COMPRESSION_AUTO, true}};
+  auto columns = MakeColumns();
+
+  printf("%-14s %-8s %12s %12s %10s %12s\n", "column", "policy", "raw MB", "write MB/s", "ratio", "read MB/s");
+  for (auto &column : columns) {
+    double raw_mb = column.values.size() / 1048576.0;
+    for (auto &policy : policies) {
+      if (policy.compression == CompressionType::COMPRESSION_LZ4 &&
+          !arrow::util::Codec::IsAvailable(arrow::Compression::LZ4)) {
+        continue;
+      }
+      if (policy.compression == CompressionType::COMPRESSION_ZSTD &&
+          !arrow::util::Codec::IsAvailable(arrow::Compression::ZSTD)) {
+        continue;
+      }
+
+      CPayloadWriter writer = nullptr;
+      auto write = Seconds([&] {
+        if (writer != nullptr) ReleasePayloadWriter(writer);
+        writer = NewPayloadWriter(column.type);
+        auto st = SetPayloadWriterOptions(writer, policy.compression, policy.autoEncoding);
+        ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+        st = AddColumn(writer, column);
+        ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+        st = FinishPayloadWriter(writer);
+        ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+      });
+      auto cb = GetPayloadBufferFromWriter(writer);
+      ASSERT_GT(cb.length, 0);
+
+      auto read = Seconds([&] {
+        auto reader = NewPayloadReader(column.type, reinterpret_cast<uint8_t *>(cb.data), cb.length);
+        ASSERT_NE(reader, nullptr);
+        auto [values, st] = ReadColumn(reader, column);
+        ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+        ASSERT_EQ(memcmp(values, column.values.data(), column.values.size()), 0);
+        st = ReleasePayloadReader(reader);
+        ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+      });
+
+      printf("%-14s %-8s %12.1f %12.1f %10.3f %12.1f\n",
+             column.name.c_str(),
+             policy.name.c_str(),
+             raw_mb,
+             raw_mb / write,
+             static_cast<double>(cb.length) / column.values.size(),
+             raw_mb / read);
+      auto st = ReleasePayloadWriter(writer);
+      ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+    }
+  }
+}
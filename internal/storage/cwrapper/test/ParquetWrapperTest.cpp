@@ -15,6 +15,8 @@
 #include <arrow/io/api.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
+#include <parquet/file_reader.h>
+#include <algorithm>
 #include "ParquetWrapper.h"
 #include "ColumnType.h"
 #include "PayloadStream.h"
@@ -314,3 +316,225 @@ TEST(wrapper, int8_2) {
   ASSERT_EQ(bool_array->Value(2), -100);
   ASSERT_EQ(bool_array->Value(3), 100);
 }
+
+TEST(wrapper, single_row_group) {
+  // readers that predate the concatenation in NewPayloadReader only see the first row group
+  const int dim = 128;
+  const int rows = 100000;
+  std::vector<float> data(dim * rows);
+  auto payload = NewPayloadWriter(ColumnType::VECTOR_FLOAT);
+  auto st = AddFloatVectorToPayload(payload, data.data(), dim, rows);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  auto cb = GetPayloadBufferFromWriter(payload);
+
+  auto input = std::make_shared<arrow::io::BufferReader>(reinterpret_cast<const uint8_t *>(cb.data), cb.length);
+  auto reader = parquet::ParquetFileReader::Open(input);
+  ASSERT_EQ(reader->metadata()->num_row_groups(), 1);
+  ReleasePayloadWriter(payload);
+}
+
+TEST(wrapper, payload_chunk) {
+  const int dim = 128;
+  const int rows = 100000;
+  std::vector<float> data(dim * rows);
+  for (int i = 0; i < dim * rows; i++) {
+    data[i] = i;
+  }
+  auto payload = NewPayloadWriter(ColumnType::VECTOR_FLOAT);
+  auto st = AddFloatVectorToPayload(payload, data.data(), dim, rows);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  auto cb = GetPayloadBufferFromWriter(payload);
+
+  auto reader = NewPayloadReader(ColumnType::VECTOR_FLOAT, (uint8_t *) cb.data, cb.length);
+  ASSERT_NE(reader, nullptr);
+  float *reader_values;
+  int d, length;
+  st = GetFloatVectorFromPayload(reader, &reader_values, &d, &length);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+
+  CPayloadChunk chunk;
+  st = GetChunkFromPayload(reader, &chunk);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_NE(chunk, nullptr);
+  // the chunk outlives the reader
+  st = ReleasePayloadReader(reader);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+
+  void *values;
+  st = GetValuesFromPayloadChunk(chunk, &values, &d, &length);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(d, dim);
+  ASSERT_EQ(length, rows);
+  ASSERT_EQ(length, GetPayloadLengthFromChunk(chunk));
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(values) % 64, 0);
+  // aligned values are not copied again
+  if (reinterpret_cast<uintptr_t>(reader_values) % 64 == 0) {
+    ASSERT_EQ(values, reader_values);
+  }
+  ASSERT_EQ(memcmp(values, data.data(), data.size() * sizeof(float)), 0);
+
+  st = ReleasePayloadChunk(chunk);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = ReleasePayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+}
+
+TEST(wrapper, payload_chunk_boolean) {
+  auto payload = NewPayloadWriter(ColumnType::BOOL);
+  bool data[] = {true, false, true, false, false};
+  auto st = AddBooleanToPayload(payload, data, 5);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  auto cb = GetPayloadBufferFromWriter(payload);
+
+  // type mismatch is reported by the chunk
+  auto reader = NewPayloadReader(ColumnType::INT8, (uint8_t *) cb.data, cb.length);
+  ASSERT_NE(reader, nullptr);
+  CPayloadChunk chunk;
+  st = GetChunkFromPayload(reader, &chunk);
+  ASSERT_NE(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(chunk, nullptr);
+  free((void *) st.error_msg);
+  ReleasePayloadReader(reader);
+
+  reader = NewPayloadReader(ColumnType::BOOL, (uint8_t *) cb.data, cb.length);
+  ASSERT_NE(reader, nullptr);
+  st = GetChunkFromPayload(reader, &chunk);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_NE(chunk, nullptr);
+  ReleasePayloadReader(reader);
+
+  void *values;
+  int dim, length;
+  st = GetValuesFromPayloadChunk(chunk, &values, &dim, &length);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(dim, 1);
+  ASSERT_EQ(length, 5);
+  for (int i = 0; i < length; i++) {
+    ASSERT_EQ(data[i], reinterpret_cast<bool *>(values)[i]);
+  }
+  ReleasePayloadChunk(chunk);
+  ReleasePayloadWriter(payload);
+}
+
+static std::unique_ptr<parquet::ColumnChunkMetaData> ColumnChunkOf(CBuffer cb) {
+  auto input = std::make_shared<arrow::io::BufferReader>(reinterpret_cast<const uint8_t *>(cb.data), cb.length);
+  auto reader = parquet::ParquetFileReader::Open(input);
+  return reader->metadata()->RowGroup(0)->ColumnChunk(0);
+}
+
+TEST(wrapper, writer_options) {
+  std::vector<double> data(10000);
+  for (int i = 0; i < static_cast<int>(data.size()); i++) {
+    data[i] = i * 0.25;
+  }
+
+  auto payload = NewPayloadWriter(ColumnType::DOUBLE);
+  auto st = SetPayloadWriterOptions(payload, 100, true);
+  ASSERT_EQ(st.error_code, ErrorCode::ILLEGAL_ARGUMENT);
+  free((void *) st.error_msg);
+  st = SetPayloadWriterOptions(payload, CompressionType::COMPRESSION_ZSTD, true);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = AddDoubleToPayload(payload, data.data(), data.size());
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = SetPayloadWriterOptions(payload, CompressionType::COMPRESSION_NONE, false);
+  ASSERT_NE(st.error_code, ErrorCode::SUCCESS);
+  free((void *) st.error_msg);
+
+  auto cb = GetPayloadBufferFromWriter(payload);
+  auto column = ColumnChunkOf(cb);
+  ASSERT_EQ(column->compression(), arrow::Compression::ZSTD);
+  auto encodings = column->encodings();
+  ASSERT_NE(std::find(encodings.begin(), encodings.end(), parquet::Encoding::BYTE_STREAM_SPLIT), encodings.end());
+
+  auto reader = NewPayloadReader(ColumnType::DOUBLE, (uint8_t *) cb.data, cb.length);
+  double *values;
+  int length;
+  st = GetDoubleFromPayload(reader, &values, &length);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(length, static_cast<int>(data.size()));
+  for (int i = 0; i < length; i++) {
+    ASSERT_EQ(values[i], data[i]);
+  }
+
+  st = ReleasePayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = ReleasePayloadReader(reader);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+}
+
+TEST(wrapper, writer_auto_options) {
+  // few distinct values are dictionary encoded, and left uncompressed by default
+  std::vector<int32_t> labels(10000);
+  for (int i = 0; i < static_cast<int>(labels.size()); i++) {
+    labels[i] = i % 4;
+  }
+  auto payload = NewPayloadWriter(ColumnType::INT32);
+  auto st = AddInt32ToPayload(payload, labels.data(), labels.size());
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  auto column = ColumnChunkOf(GetPayloadBufferFromWriter(payload));
+  ASSERT_TRUE(column->has_dictionary_page());
+  ASSERT_EQ(column->compression(), arrow::Compression::UNCOMPRESSED);
+  st = ReleasePayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+
+  std::vector<uint8_t> bits(10000 * 16);
+  uint64_t seed = 42;
+  for (auto &b : bits) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    b = static_cast<uint8_t>(seed >> 56);
+  }
+  // random bits are left uncompressed by the auto policy
+  payload = NewPayloadWriter(ColumnType::VECTOR_BINARY);
+  st = SetPayloadWriterOptions(payload, CompressionType::COMPRESSION_AUTO, true);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = AddBinaryVectorToPayload(payload, bits.data(), 128, 10000);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  auto cb = GetPayloadBufferFromWriter(payload);
+  column = ColumnChunkOf(cb);
+  ASSERT_FALSE(column->has_dictionary_page());
+  ASSERT_EQ(column->compression(), arrow::Compression::UNCOMPRESSED);
+
+  auto reader = NewPayloadReader(ColumnType::VECTOR_BINARY, (uint8_t *) cb.data, cb.length);
+  uint8_t *values;
+  int length;
+  int dim;
+  st = GetBinaryVectorFromPayload(reader, &values, &dim, &length);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(dim, 128);
+  ASSERT_EQ(length, 10000);
+  ASSERT_EQ(memcmp(values, bits.data(), bits.size()), 0);
+
+  st = ReleasePayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = ReleasePayloadReader(reader);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+
+  // distinct doubles are byte stream split only when compressed
+  std::vector<double> doubles(10000);
+  for (int i = 0; i < static_cast<int>(doubles.size()); i++) {
+    doubles[i] = i * 0.25;
+  }
+  payload = NewPayloadWriter(ColumnType::DOUBLE);
+  st = AddDoubleToPayload(payload, doubles.data(), doubles.size());
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  column = ColumnChunkOf(GetPayloadBufferFromWriter(payload));
+  ASSERT_EQ(column->compression(), arrow::Compression::UNCOMPRESSED);
+  auto encodings = column->encodings();
+  ASSERT_EQ(std::find(encodings.begin(), encodings.end(), parquet::Encoding::BYTE_STREAM_SPLIT), encodings.end());
+  st = ReleasePayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+}
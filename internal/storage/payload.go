@@ -14,7 +14,7 @@ package storage
 /*
 #cgo CFLAGS: -I${SRCDIR}/cwrapper
 
-#cgo LDFLAGS: -L${SRCDIR}/cwrapper/output -lwrapper -lparquet -larrow -lthrift -lutf8proc -lstdc++ -lm
+#cgo LDFLAGS: -L${SRCDIR}/cwrapper/output -lwrapper -lparquet -larrow -lthrift -lutf8proc -llz4 -lzstd -lstdc++ -lm
 #include <stdlib.h>
 #include "ParquetWrapper.h"
 */
@@ -39,6 +39,7 @@ type PayloadWriterInterface interface {
 	AddOneStringToPayload(msgs string) error
 	AddBinaryVectorToPayload(binVec []byte, dim int) error
 	AddFloatVectorToPayload(binVec []float32, dim int) error
+	SetPayloadWriterOptions(compression PayloadCompression, autoEncoding bool) error
 	FinishPayloadWriter() error
 	GetPayloadBufferFromWriter() ([]byte, error)
 	GetPayloadLengthFromWriter() (int, error)
@@ -63,6 +64,17 @@ type PayloadReaderInterface interface {
 	Close() error
 }
 
+// PayloadCompression is the codec of a payload, see CompressionType in cwrapper/ColumnType.h.
+// Writers default to PayloadCompressionNone, which binaries built without lz4 and zstd can read.
+type PayloadCompression int32
+
+const (
+	PayloadCompressionAuto PayloadCompression = 0
+	PayloadCompressionNone PayloadCompression = 1
+	PayloadCompressionLZ4  PayloadCompression = 2
+	PayloadCompressionZstd PayloadCompression = 3
+)
+
 type PayloadWriter struct {
 	payloadWriterPtr C.CPayloadWriter
 	colType          schemapb.DataType
@@ -366,6 +378,18 @@ func (w *PayloadWriter) AddFloatVectorToPayload(floatVec []float32, dim int) err
 	return nil
 }
 
+// SetPayloadWriterOptions must be called before FinishPayloadWriter
+func (w *PayloadWriter) SetPayloadWriterOptions(compression PayloadCompression, autoEncoding bool) error {
+	st := C.SetPayloadWriterOptions(w.payloadWriterPtr, C.int(compression), C.bool(autoEncoding))
+	errCode := commonpb.ErrorCode(st.error_code)
+	if errCode != commonpb.ErrorCode_Success {
+		msg := C.GoString(st.error_msg)
+		defer C.free(unsafe.Pointer(st.error_msg))
+		return errors.New(msg)
+	}
+	return nil
+}
+
 func (w *PayloadWriter) FinishPayloadWriter() error {
 	st := C.FinishPayloadWriter(w.payloadWriterPtr)
 	errCode := commonpb.ErrorCode(st.error_code)
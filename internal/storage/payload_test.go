@@ -280,6 +280,35 @@ func TestPayload_ReaderandWriter(t *testing.T) {
 		defer r.ReleasePayloadReader()
 	})
 
+	t.Run("TestWriterOptions", func(t *testing.T) {
+		w, err := NewPayloadWriter(schemapb.DataType_Double)
+		require.Nil(t, err)
+		require.NotNil(t, w)
+		defer w.ReleasePayloadWriter()
+
+		err = w.SetPayloadWriterOptions(PayloadCompression(100), true)
+		assert.NotNil(t, err)
+		err = w.SetPayloadWriterOptions(PayloadCompressionAuto, true)
+		assert.Nil(t, err)
+
+		err = w.AddDoubleToPayload([]float64{1.0, 2.0, 3.0})
+		assert.Nil(t, err)
+		err = w.FinishPayloadWriter()
+		assert.Nil(t, err)
+		err = w.SetPayloadWriterOptions(PayloadCompressionNone, true)
+		assert.NotNil(t, err)
+
+		buffer, err := w.GetPayloadBufferFromWriter()
+		assert.Nil(t, err)
+
+		r, err := NewPayloadReader(schemapb.DataType_Double, buffer)
+		require.Nil(t, err)
+		defer r.ReleasePayloadReader()
+		float64s, err := r.GetDoubleFromPayload()
+		assert.Nil(t, err)
+		assert.ElementsMatch(t, []float64{1.0, 2.0, 3.0}, float64s)
+	})
+
 	t.Run("TestAddOneString", func(t *testing.T) {
 		w, err := NewPayloadWriter(schemapb.DataType_String)
 		require.Nil(t, err)
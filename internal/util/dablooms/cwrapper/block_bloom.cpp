@@ -0,0 +1,263 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "block_bloom.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "murmur.h"
+
+namespace {
+
+constexpr int kWordsPerBlock = 8;
+constexpr size_t kBlockBytes = kWordsPerBlock * sizeof(uint32_t);
+// the salts of the parquet split block bloom filter
+constexpr uint32_t kSalt[kWordsPerBlock] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                            0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+constexpr uint32_t kSeed = 0x97c29b3a;
+constexpr uint32_t kMagic = 0x31464242;  // "BBF1"
+// the block index is taken from the high 32 bits of the hash
+constexpr uint64_t kMaxBlocks = uint64_t(1) << 32;
+constexpr int kPrefetchDistance = 16;
+
+struct Header {
+    uint32_t magic;
+    uint32_t reserved;
+    uint64_t num_blocks;
+};
+
+struct alignas(kBlockBytes) Block {
+    uint32_t words[kWordsPerBlock];
+};
+
+inline uint64_t
+hash_int64(int64_t key) {
+    // fmix64 of murmur3
+    auto k = static_cast<uint64_t>(key);
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+inline uint64_t
+hash_bytes(const char* s, size_t len) {
+    uint64_t out[2];
+    MurmurHash3_x64_128(s, static_cast<int>(len), kSeed, out);
+    return out[0];
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) bool
+check_block_avx2(const Block* block, uint32_t key) {
+    const __m256i salt = _mm256_setr_epi32(kSalt[0], kSalt[1], kSalt[2], kSalt[3], kSalt[4], kSalt[5], kSalt[6],
+                                           kSalt[7]);
+    auto bit = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(key), salt), 27);
+    auto mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), bit);
+    auto words = _mm256_load_si256(reinterpret_cast<const __m256i*>(block->words));
+    // (~words & mask) == 0
+    return _mm256_testc_si256(words, mask);
+}
+
+const bool use_avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+inline bool
+check_block(const Block* block, uint32_t key) {
+#if defined(__x86_64__)
+    if (use_avx2) {
+        return check_block_avx2(block, key);
+    }
+#endif
+    uint32_t missing = 0;
+    for (int i = 0; i < kWordsPerBlock; ++i) {
+        auto mask = uint32_t(1) << ((key * kSalt[i]) >> 27);
+        missing |= ~__atomic_load_n(&block->words[i], __ATOMIC_RELAXED) & mask;
+    }
+    return missing == 0;
+}
+
+inline void
+add_block(Block* block, uint32_t key) {
+    for (int i = 0; i < kWordsPerBlock; ++i) {
+        auto mask = uint32_t(1) << ((key * kSalt[i]) >> 27);
+        __atomic_fetch_or(&block->words[i], mask, __ATOMIC_RELAXED);
+    }
+}
+
+// false positive rate at keys_per_block keys per block on average: the keys of a block are Poisson
+// distributed, and an absent key with c keys in its block hits when each of its 8 bits is already set
+double
+false_positive_rate(double keys_per_block) {
+    constexpr double kMiss = 1 - 1.0 / 32;
+    double rate = 0;
+    double poisson = std::exp(-keys_per_block);
+    for (int64_t c = 0;; ++c) {
+        rate += poisson * std::pow(1 - std::pow(kMiss, c), kWordsPerBlock);
+        if (c > keys_per_block && poisson < 1e-12) {
+            break;
+        }
+        poisson *= keys_per_block / (c + 1);
+    }
+    return rate;
+}
+
+}  // namespace
+
+struct block_bloom_s {
+    uint64_t num_blocks;
+    Block* blocks;
+
+    Block*
+    block_of(uint64_t hash) const {
+        return blocks + (((hash >> 32) * num_blocks) >> 32);
+    }
+};
+
+static block_bloom_t*
+alloc_block_bloom(uint64_t num_blocks) {
+    auto bloom = new (std::nothrow) block_bloom_t;
+    if (bloom == nullptr) {
+        return nullptr;
+    }
+    bloom->num_blocks = num_blocks;
+    bloom->blocks = static_cast<Block*>(aligned_alloc(kBlockBytes, num_blocks * kBlockBytes));
+    if (bloom->blocks == nullptr) {
+        delete bloom;
+        return nullptr;
+    }
+    memset(bloom->blocks, 0, num_blocks * kBlockBytes);
+    return bloom;
+}
+
+block_bloom_t*
+new_block_bloom(uint64_t capacity, double error_rate) {
+    if (capacity == 0 || !(error_rate > 0 && error_rate < 1)) {
+        return nullptr;
+    }
+    // the classic bloom estimate is a lower bound, double it until the block model meets the rate
+    double bits = -8.0 * capacity / std::log(1 - std::pow(error_rate, 1.0 / kWordsPerBlock));
+    uint64_t lo = std::max<uint64_t>(1, std::min<uint64_t>(bits / (kBlockBytes * 8), kMaxBlocks));
+    uint64_t hi = lo;
+    while (hi < kMaxBlocks && false_positive_rate(static_cast<double>(capacity) / hi) > error_rate) {
+        lo = hi;
+        hi = std::min(hi * 2, kMaxBlocks);
+    }
+    // smallest block count in (lo, hi] that meets the rate
+    while (lo + 1 < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (false_positive_rate(static_cast<double>(capacity) / mid) > error_rate) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return alloc_block_bloom(hi);
+}
+
+void
+free_block_bloom(block_bloom_t* bloom) {
+    if (bloom != nullptr) {
+        free(bloom->blocks);
+        delete bloom;
+    }
+}
+
+void
+block_bloom_add(block_bloom_t* bloom, const char* s, size_t len) {
+    auto hash = hash_bytes(s, len);
+    add_block(bloom->block_of(hash), static_cast<uint32_t>(hash));
+}
+
+int
+block_bloom_check(const block_bloom_t* bloom, const char* s, size_t len) {
+    auto hash = hash_bytes(s, len);
+    return check_block(bloom->block_of(hash), static_cast<uint32_t>(hash));
+}
+
+void
+block_bloom_add_many(block_bloom_t* bloom, const int64_t* keys, size_t num_keys) {
+    for (size_t i = 0; i < num_keys; ++i) {
+        auto hash = hash_int64(keys[i]);
+        add_block(bloom->block_of(hash), static_cast<uint32_t>(hash));
+    }
+}
+
+void
+block_bloom_check_many(const block_bloom_t* bloom, const int64_t* keys, size_t num_keys, uint8_t* results) {
+    // hash and prefetch a few keys ahead, so the cache misses of a batch overlap
+    uint64_t hashes[kPrefetchDistance];
+    for (size_t i = 0; i < num_keys && i < kPrefetchDistance; ++i) {
+        hashes[i] = hash_int64(keys[i]);
+        __builtin_prefetch(bloom->block_of(hashes[i]));
+    }
+    for (size_t i = 0; i < num_keys; ++i) {
+        auto hash = hashes[i % kPrefetchDistance];
+        if (i + kPrefetchDistance < num_keys) {
+            auto& next = hashes[i % kPrefetchDistance];
+            next = hash_int64(keys[i + kPrefetchDistance]);
+            __builtin_prefetch(bloom->block_of(next));
+        }
+        results[i] = check_block(bloom->block_of(hash), static_cast<uint32_t>(hash));
+    }
+}
+
+size_t
+block_bloom_size(const block_bloom_t* bloom) {
+    return sizeof(Header) + bloom->num_blocks * kBlockBytes;
+}
+
+// the layout is the header followed by the blocks, in host byte order
+size_t
+block_bloom_serialize(const block_bloom_t* bloom, char* out, size_t len) {
+    auto size = block_bloom_size(bloom);
+    if (len < size) {
+        return 0;
+    }
+    Header header{kMagic, 0, bloom->num_blocks};
+    memcpy(out, &header, sizeof(Header));
+    for (uint64_t i = 0; i < bloom->num_blocks; ++i) {
+        auto dst = out + sizeof(Header) + i * kBlockBytes;
+        for (int j = 0; j < kWordsPerBlock; ++j) {
+            auto word = __atomic_load_n(&bloom->blocks[i].words[j], __ATOMIC_RELAXED);
+            memcpy(dst + j * sizeof(uint32_t), &word, sizeof(uint32_t));
+        }
+    }
+    return size;
+}
+
+block_bloom_t*
+block_bloom_deserialize(const char* data, size_t len) {
+    if (len < sizeof(Header)) {
+        return nullptr;
+    }
+    Header header;
+    memcpy(&header, data, sizeof(Header));
+    if (header.magic != kMagic || header.num_blocks == 0 || header.num_blocks > kMaxBlocks ||
+        len != sizeof(Header) + header.num_blocks * kBlockBytes) {
+        return nullptr;
+    }
+    auto bloom = alloc_block_bloom(header.num_blocks);
+    if (bloom == nullptr) {
+        return nullptr;
+    }
+    memcpy(bloom->blocks, data + sizeof(Header), header.num_blocks * kBlockBytes);
+    return bloom;
+}
@@ -0,0 +1,60 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// split block bloom filter, every key sets 8 bits in a single 32 bytes block,
+// so a probe touches one cache line.
+// adds are atomic and checks never write, any number of threads may add and check concurrently.
+typedef struct block_bloom_s block_bloom_t;
+
+// returns NULL if capacity is 0 or error_rate is not in (0, 1)
+block_bloom_t*
+new_block_bloom(uint64_t capacity, double error_rate);
+
+void
+free_block_bloom(block_bloom_t* bloom);
+
+// byte keys and int64 keys are hashed differently, a filter should only see one of them
+void
+block_bloom_add(block_bloom_t* bloom, const char* s, size_t len);
+
+int
+block_bloom_check(const block_bloom_t* bloom, const char* s, size_t len);
+
+void
+block_bloom_add_many(block_bloom_t* bloom, const int64_t* keys, size_t num_keys);
+
+// results[i] is set to 1 if keys[i] may be in the filter, 0 otherwise
+void
+block_bloom_check_many(const block_bloom_t* bloom, const int64_t* keys, size_t num_keys, uint8_t* results);
+
+size_t
+block_bloom_size(const block_bloom_t* bloom);
+
+// returns the bytes written, 0 if len is smaller than block_bloom_size()
+size_t
+block_bloom_serialize(const block_bloom_t* bloom, char* out, size_t len);
+
+// returns NULL if data is not a serialized filter
+block_bloom_t*
+block_bloom_deserialize(const char* data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,40 +16,77 @@ package dablooms
 
 #cgo LDFLAGS: -L${SRCDIR}/cwrapper/output -ldablooms -lstdc++ -lm
 #include <stdlib.h>
-#include <dablooms.h>
+#include <block_bloom.h>
 */
 import "C"
 
 import (
+	"errors"
 	"unsafe"
 )
 
-type ScalingBloom struct {
-	cfilter *C.scaling_bloom_t
+// BlockBloom is a split block bloom filter, a key is hashed to a single 32 bytes block,
+// so Check costs one memory access. Add and Check are safe to call concurrently.
+type BlockBloom struct {
+	cfilter *C.block_bloom_t
 }
 
-func NewScalingBloom(capacity uint64, errorRate float64) *ScalingBloom {
-	sb := &ScalingBloom{
-		cfilter: C.new_scaling_bloom(C.uint(capacity), C.double(errorRate)),
+func NewBlockBloom(capacity uint64, errorRate float64) (*BlockBloom, error) {
+	cfilter := C.new_block_bloom(C.uint64_t(capacity), C.double(errorRate))
+	if cfilter == nil {
+		return nil, errors.New("invalid bloom filter capacity or error rate")
 	}
-	return sb
+	return &BlockBloom{cfilter: cfilter}, nil
 }
 
-func (sb *ScalingBloom) Destroy() {
-	C.free_scaling_bloom(sb.cfilter)
+func (bb *BlockBloom) Destroy() {
+	C.free_block_bloom(bb.cfilter)
+	bb.cfilter = nil
 }
 
-func (sb *ScalingBloom) Add(key []byte, id int64) bool {
-	cKey := (*C.char)(unsafe.Pointer(&key[0]))
-	return C.scaling_bloom_add(sb.cfilter, cKey, C.size_t(len(key)), C.uint64_t(id)) == 1
+func bytesPtr(key []byte) *C.char {
+	if len(key) == 0 {
+		return nil
+	}
+	return (*C.char)(unsafe.Pointer(&key[0]))
+}
+
+func (bb *BlockBloom) Add(key []byte) {
+	C.block_bloom_add(bb.cfilter, bytesPtr(key), C.size_t(len(key)))
+}
+
+func (bb *BlockBloom) Check(key []byte) bool {
+	return C.block_bloom_check(bb.cfilter, bytesPtr(key), C.size_t(len(key))) == 1
+}
+
+// AddInt64s and CheckInt64s hash int64 keys directly, they don't match keys added by Add
+func (bb *BlockBloom) AddInt64s(keys []int64) {
+	if len(keys) == 0 {
+		return
+	}
+	C.block_bloom_add_many(bb.cfilter, (*C.int64_t)(unsafe.Pointer(&keys[0])), C.size_t(len(keys)))
+}
+
+func (bb *BlockBloom) CheckInt64s(keys []int64) []bool {
+	results := make([]bool, len(keys))
+	if len(keys) == 0 {
+		return results
+	}
+	C.block_bloom_check_many(bb.cfilter, (*C.int64_t)(unsafe.Pointer(&keys[0])), C.size_t(len(keys)),
+		(*C.uint8_t)(unsafe.Pointer(&results[0])))
+	return results
 }
 
-func (sb *ScalingBloom) Remove(key []byte, id int64) bool {
-	cKey := (*C.char)(unsafe.Pointer(&key[0]))
-	return C.scaling_bloom_remove(sb.cfilter, cKey, C.size_t(len(key)), C.uint64_t(id)) == 1
+func (bb *BlockBloom) Marshal() []byte {
+	buf := make([]byte, int(C.block_bloom_size(bb.cfilter)))
+	C.block_bloom_serialize(bb.cfilter, bytesPtr(buf), C.size_t(len(buf)))
+	return buf
 }
 
-func (sb *ScalingBloom) Check(key []byte) bool {
-	cKey := (*C.char)(unsafe.Pointer(&key[0]))
-	return C.scaling_bloom_check(sb.cfilter, cKey, C.size_t(len(key))) == 1
+func UnmarshalBlockBloom(data []byte) (*BlockBloom, error) {
+	cfilter := C.block_bloom_deserialize(bytesPtr(data), C.size_t(len(data)))
+	if cfilter == nil {
+		return nil, errors.New("invalid serialized bloom filter")
+	}
+	return &BlockBloom{cfilter: cfilter}, nil
 }
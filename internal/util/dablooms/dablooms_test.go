@@ -30,6 +30,9 @@ type stats struct {
 var Capacity uint64 = 1000000
 var ErrorRate float64 = .05
 
+// relative slack over ErrorRate for the sampling noise of Capacity checks
+var ErrorRateMargin float64 = 1.05
+
 func PrintResults(stats *stats) {
 	falsePositiveRate := float64(stats.FalsePositives) / float64(stats.FalsePositives+stats.TrueNegatives)
 	fmt.Printf("True positives:		%7d\n", stats.TruePositives)
@@ -44,14 +47,15 @@ func PrintResults(stats *stats) {
 }
 
 func TestDablooms_Correctness(t *testing.T) {
-	sb := NewScalingBloom(Capacity, ErrorRate)
-	assert.NotNil(t, sb)
+	bb, err := NewBlockBloom(Capacity, ErrorRate)
+	assert.Nil(t, err)
+	assert.NotNil(t, bb)
 
 	start := time.Now().UnixNano()
 	for i := 0; i < int(Capacity*2); i++ {
 		if i%2 == 0 {
 			key := strconv.Itoa(i)
-			sb.Add([]byte(key), int64(i))
+			bb.Add([]byte(key))
 		}
 	}
 	end := time.Now().UnixNano()
@@ -68,9 +72,15 @@ func TestDablooms_Correctness(t *testing.T) {
 
 	start = time.Now().UnixNano()
 	for i := 0; i < int(Capacity*2); i++ {
-		if i%2 == 1 {
-			key := strconv.Itoa(i)
-			positive := sb.Check([]byte(key))
+		key := strconv.Itoa(i)
+		positive := bb.Check([]byte(key))
+		if i%2 == 0 {
+			if positive {
+				results.TruePositives++
+			} else {
+				results.FalseNegatives++
+			}
+		} else {
 			if positive {
 				results.FalsePositives++
 			} else {
@@ -82,10 +92,50 @@ func TestDablooms_Correctness(t *testing.T) {
 	seconds = float64((end - start) / 1e9)
 	fmt.Printf("Time cost for check: %fs\n", seconds)
 
-	sb.Destroy()
+	bb.Destroy()
 
 	PrintResults(results)
 
 	// False negatives means that there should
 	assert.False(t, results.FalseNegatives > 0)
+	assert.True(t, float64(results.FalsePositives) <= ErrorRateMargin*ErrorRate*float64(Capacity))
+}
+
+func TestDablooms_Int64s(t *testing.T) {
+	bb, err := NewBlockBloom(Capacity, ErrorRate)
+	assert.Nil(t, err)
+
+	keys := make([]int64, 0, Capacity)
+	absent := make([]int64, 0, Capacity)
+	for i := int64(0); i < int64(Capacity); i++ {
+		keys = append(keys, i*2)
+		absent = append(absent, i*2+1)
+	}
+	bb.AddInt64s(keys)
+
+	for _, positive := range bb.CheckInt64s(keys) {
+		assert.True(t, positive)
+	}
+	falsePositives := 0
+	for _, positive := range bb.CheckInt64s(absent) {
+		if positive {
+			falsePositives++
+		}
+	}
+	assert.True(t, float64(falsePositives) <= ErrorRateMargin*ErrorRate*float64(Capacity))
+
+	// a round trip keeps every bit
+	data := bb.Marshal()
+	bb2, err := UnmarshalBlockBloom(data)
+	assert.Nil(t, err)
+	assert.Equal(t, bb.CheckInt64s(absent), bb2.CheckInt64s(absent))
+	assert.Equal(t, data, bb2.Marshal())
+
+	_, err = UnmarshalBlockBloom(data[:len(data)-1])
+	assert.NotNil(t, err)
+	_, err = NewBlockBloom(0, ErrorRate)
+	assert.NotNil(t, err)
+
+	bb.Destroy()
+	bb2.Destroy()
 }
@@ -66,6 +66,10 @@ if __name__ == "__main__":
                 'visitor_name': "ExtractInfoExprVisitor",
                 "parameter_name": 'expr',
             },
+            {
+                'visitor_name': "CostExprVisitor",
+                "parameter_name": 'expr',
+            },
         ],
         'PlanNode': [
             {